@@ -0,0 +1,184 @@
+#include "asset_bundle.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef SNAKE_EMBEDDED_ASSETS
+// Generated by AssetPacker at build time (see CMakeLists.txt)
+extern const unsigned char kEmbeddedAssetBundle[];
+extern const std::size_t   kEmbeddedAssetBundleSize;
+#endif
+
+AssetBundle::~AssetBundle() {
+  close_();
+}
+
+// Move Constructor
+AssetBundle::AssetBundle(AssetBundle &&source) : _file(std::move(source._file)) {
+  _data       = source._data;
+  _size       = source._size;
+  _entries    = source._entries;
+  _entryCount = source._entryCount;
+
+  // Invalidating source after move operation
+  source._data       = nullptr;
+  source._size       = 0;
+  source._entries    = nullptr;
+  source._entryCount = 0;
+}
+
+// Move Assignment Operator
+AssetBundle &AssetBundle::operator=(AssetBundle &&source) {
+  if (this == &source) { return *this; }  // To handle self assignment scenario
+
+  close_();
+  _file       = std::move(source._file);
+  _data       = source._data;
+  _size       = source._size;
+  _entries    = source._entries;
+  _entryCount = source._entryCount;
+
+  // Invalidating source after move operation
+  source._data       = nullptr;
+  source._size       = 0;
+  source._entries    = nullptr;
+  source._entryCount = 0;
+
+  return *this;
+}
+
+/*
+ * Prefer the bundle linked into the executable, so that a cold start
+ * does not touch the filesystem at all. Otherwise map assets.pak from
+ * the directory the executable lives in.
+ */
+bool AssetBundle::openDefault() {
+#ifdef SNAKE_EMBEDDED_ASSETS
+  return openMemory(kEmbeddedAssetBundle, kEmbeddedAssetBundleSize);
+#else
+  std::string path{kBundleFileName};
+  char *basePath = SDL_GetBasePath();
+  if (nullptr != basePath) {
+    path = std::string{basePath} + kBundleFileName;
+    SDL_free(basePath);
+  }
+  return openFile(path);
+#endif
+}
+
+// Memory-map the bundle file read-only
+bool AssetBundle::openFile(std::string const &path) {
+  close_();
+
+  if (!_file.open(path)) {
+    std::cerr << "Asset bundle " << path << " could not be opened.\n";
+    return false;
+  }
+  _data = _file.data();
+  _size = _file.size();
+
+  if (!validate_()) {
+    std::cerr << "Asset bundle " << path << " is corrupted.\n";
+    close_();
+    return false;
+  }
+  return true;
+}
+
+// Use a bundle that is already in memory, e.g. the one embedded in the executable
+bool AssetBundle::openMemory(const void *data, std::size_t size) {
+  close_();
+  _data   = static_cast<const unsigned char *>(data);
+  _size   = size;
+
+  if (!validate_()) {
+    std::cerr << "Embedded asset bundle is corrupted.\n";
+    close_();
+    return false;
+  }
+  return true;
+}
+
+bool AssetBundle::isOpen() const {
+  return nullptr != _entries;
+}
+
+// Look up an asset by name, the index is sorted so this is a binary search
+AssetBundle::AssetView AssetBundle::find(std::string const &name) const {
+  AssetView view;
+  if (!isOpen() || name.size() > AssetFormat::kMaxNameLength) { return view; }
+
+  const AssetFormat::AssetBundleEntry *end = _entries + _entryCount;
+  const AssetFormat::AssetBundleEntry *it = std::lower_bound(
+      _entries, end, name,
+      [](AssetFormat::AssetBundleEntry const &entry, std::string const &key) {
+        return AssetFormat::compareName(entry, key.c_str()) < 0;
+      });
+
+  if (it != end && AssetFormat::compareName(*it, name.c_str()) == 0) {
+    view.data = _data + it->offset;
+    view.size = static_cast<std::size_t>(it->size);
+  }
+  return view;
+}
+
+/*
+ * Wrap an asset in an SDL_RWops that reads straight from the bundle memory
+ * Falls back to the loose file in the assets directory when the asset is
+ * not packed, so a missing bundle only costs the filesystem lookup.
+ * Returns nullptr if neither is available.
+ */
+SDL_RWops *AssetBundle::openRW(std::string const &name) const {
+  AssetView view = find(name);
+  if (view) {
+    return SDL_RWFromConstMem(view.data, static_cast<int>(view.size));
+  }
+  return SDL_RWFromFile(dataPath(name).c_str(), "rb");
+}
+
+/*
+ * Resolve files in the assets directory relative to the executable instead
+ * of the current working directory, so the game can be started from anywhere
+ */
+std::string AssetBundle::dataPath(std::string const &name) {
+  std::string path{"../assets/" + name};
+  char *basePath = SDL_GetBasePath();
+  if (nullptr != basePath) {
+    path = std::string{basePath} + path;
+    SDL_free(basePath);
+  }
+  return path;
+}
+
+// Check the header and index so that lookups never read outside the bundle
+bool AssetBundle::validate_() {
+  using namespace AssetFormat;
+
+  if (nullptr == _data || _size < sizeof(AssetBundleHeader)) { return false; }
+
+  auto header = reinterpret_cast<const AssetBundleHeader *>(_data);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+    return false;
+  }
+
+  std::size_t indexSize = static_cast<std::size_t>(header->entryCount) * sizeof(AssetBundleEntry);
+  if (indexSize > _size - sizeof(AssetBundleHeader)) { return false; }
+
+  auto entries = reinterpret_cast<const AssetBundleEntry *>(_data + sizeof(AssetBundleHeader));
+  for (std::size_t i = 0; i < header->entryCount; ++i) {
+    if (entries[i].offset > _size || entries[i].size > _size - entries[i].offset) {
+      return false;
+    }
+  }
+
+  _entries    = entries;
+  _entryCount = header->entryCount;
+  return true;
+}
+
+void AssetBundle::close_() {
+  _file.close();
+  _data       = nullptr;
+  _size       = 0;
+  _entries    = nullptr;
+  _entryCount = 0;
+}
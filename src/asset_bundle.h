@@ -0,0 +1,71 @@
+#ifndef ASSET_BUNDLE_H
+#define ASSET_BUNDLE_H
+
+#include <cstddef>
+#include <string>
+#include "SDL.h"
+#include "asset_format.h"
+#include "mapped_file.h"
+
+/*
+ * Read-only view over a packed asset bundle (see asset_format.h)
+ * The bundle is either memory-mapped from disk or, when the game is built
+ * with EMBED_ASSETS, served straight from the executable image. Assets are
+ * handed out as pointers into that memory - nothing is copied.
+ */
+class AssetBundle {
+ public:
+  // A contiguous, read-only span of bytes inside the bundle
+  struct AssetView {
+    const void  *data{nullptr};
+    std::size_t  size{0};
+    explicit operator bool() const { return data != nullptr; }
+  };
+
+  // Constructor
+  AssetBundle() = default;
+
+  // Destructor
+  ~AssetBundle();
+
+  /*
+   * Rule of 5 implementation
+   * Adopting a "No Copy, Only Move" memory management policy
+   */
+  AssetBundle(const AssetBundle &) = delete;             // Delete copy constructor
+  AssetBundle &operator=(const AssetBundle &) = delete;  // Delete copy assignment operator
+
+  // Move Constructor
+  AssetBundle(AssetBundle &&source);
+
+  // Move Assignment Operator
+  AssetBundle &operator=(AssetBundle &&source);
+
+  // Public methods
+  bool openDefault();
+  bool openFile(std::string const &path);
+  bool openMemory(const void *data, std::size_t size);
+  bool isOpen() const;
+  AssetView find(std::string const &name) const;
+  SDL_RWops *openRW(std::string const &name) const;
+
+  // Absolute path of a loose file shipped in the assets directory
+  static std::string dataPath(std::string const &name);
+
+  // Public data
+  const std::string kBundleFileName{"assets.pak"};
+
+ private:
+  // Private methods
+  bool validate_();
+  void close_();
+
+  // Private data
+  MappedFile                            _file{};  // Unused for in-memory bundles
+  const unsigned char                  *_data{nullptr};
+  std::size_t                           _size{0};
+  const AssetFormat::AssetBundleEntry  *_entries{nullptr};
+  std::size_t                           _entryCount{0};
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef ASSET_FORMAT_H
+#define ASSET_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * On-disk layout of the packed asset bundle (assets.pak)
+ *
+ *   AssetBundleHeader
+ *   AssetBundleEntry[entryCount]   <- sorted by name for binary search
+ *   payload bytes                  <- each entry aligned to kAssetAlignment
+ *
+ * All fields are stored in the host byte order; the bundle is produced by
+ * the AssetPacker tool at build time for the machine it is deployed on.
+ * Kept free of any SDL dependency so the packer can include it directly.
+ */
+namespace AssetFormat {
+
+constexpr char          kMagic[4]{'S', 'N', 'K', 'B'};
+constexpr std::uint32_t kVersion{1};
+constexpr std::uint32_t kAssetAlignment{16};
+constexpr std::size_t   kMaxNameLength{48};
+
+// Kind of payload stored in an entry
+enum class AssetType : std::uint32_t { kData = 0, kSound = 1, kFont = 2, kSprite = 3 };
+
+struct AssetBundleHeader {
+  char          magic[4];
+  std::uint32_t version;
+  std::uint32_t entryCount;
+  std::uint32_t reserved;
+};
+
+struct AssetBundleEntry {
+  char          name[kMaxNameLength];  // NUL padded, not necessarily NUL terminated
+  AssetType     type;
+  std::uint32_t reserved;
+  std::uint64_t offset;                // From the start of the bundle
+  std::uint64_t size;
+};
+
+static_assert(sizeof(AssetBundleHeader) == 16, "Unexpected bundle header layout");
+static_assert(sizeof(AssetBundleEntry) == 72, "Unexpected bundle entry layout");
+
+// Compare an entry name with a lookup key the same way the packer sorted them
+inline int compareName(AssetBundleEntry const &entry, const char *name) {
+  return std::strncmp(entry.name, name, kMaxNameLength);
+}
+
+}  // namespace AssetFormat
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * AssetPacker - build time tool that packs loose asset files into a
+ * single bundle (see asset_format.h)
+ *
+ * Usage: AssetPacker -o <bundle.pak> [--cpp <embedded.cpp>] <files...>
+ *
+ * With --cpp the bundle is additionally emitted as a C++ byte array so it
+ * can be linked into the game executable.
+ */
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "asset_format.h"
+
+namespace {
+
+struct InputAsset {
+  std::string                name;
+  AssetFormat::AssetType     type;
+  std::vector<unsigned char> bytes;
+};
+
+std::string baseName(std::string const &path) {
+  std::size_t slash = path.find_last_of("/\\");
+  return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+// Derive the asset type from the file extension
+AssetFormat::AssetType assetType(std::string const &name) {
+  std::size_t dot = name.find_last_of('.');
+  std::string extension = (dot == std::string::npos) ? "" : name.substr(dot + 1);
+  if (extension == "wav" || extension == "ogg") { return AssetFormat::AssetType::kSound;  }
+  if (extension == "ttf" || extension == "otf") { return AssetFormat::AssetType::kFont;   }
+  if (extension == "png" || extension == "bmp") { return AssetFormat::AssetType::kSprite; }
+  return AssetFormat::AssetType::kData;
+}
+
+bool readAsset(std::string const &path, InputAsset &asset) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open " << path << "\n";
+    return false;
+  }
+  asset.name = baseName(path);
+  if (asset.name.size() > AssetFormat::kMaxNameLength) {
+    std::cerr << "Asset name " << asset.name << " is too long\n";
+    return false;
+  }
+  asset.type = assetType(asset.name);
+  asset.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+std::vector<unsigned char> buildBundle(std::vector<InputAsset> const &assets) {
+  using namespace AssetFormat;
+
+  AssetBundleHeader header{};
+  std::copy(std::begin(kMagic), std::end(kMagic), header.magic);
+  header.version    = kVersion;
+  header.entryCount = static_cast<std::uint32_t>(assets.size());
+
+  std::vector<AssetBundleEntry> entries(assets.size());
+  std::size_t offset = sizeof(AssetBundleHeader) + entries.size() * sizeof(AssetBundleEntry);
+  for (std::size_t i = 0; i < assets.size(); ++i) {
+    offset = (offset + kAssetAlignment - 1) / kAssetAlignment * kAssetAlignment;
+    std::copy(assets[i].name.begin(), assets[i].name.end(), entries[i].name);
+    entries[i].type   = assets[i].type;
+    entries[i].offset = offset;
+    entries[i].size   = assets[i].bytes.size();
+    offset += assets[i].bytes.size();
+  }
+
+  std::vector<unsigned char> bundle(offset, 0);
+  auto headerBytes = reinterpret_cast<const unsigned char *>(&header);
+  std::copy(headerBytes, headerBytes + sizeof(header), bundle.begin());
+  auto entryBytes = reinterpret_cast<const unsigned char *>(entries.data());
+  std::copy(entryBytes, entryBytes + entries.size() * sizeof(AssetBundleEntry),
+            bundle.begin() + sizeof(header));
+  for (std::size_t i = 0; i < assets.size(); ++i) {
+    std::copy(assets[i].bytes.begin(), assets[i].bytes.end(), bundle.begin() + entries[i].offset);
+  }
+  return bundle;
+}
+
+bool writeCpp(std::string const &path, std::vector<unsigned char> const &bundle) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Failed to write " << path << "\n";
+    return false;
+  }
+  file << "// Generated by AssetPacker, do not edit\n";
+  file << "#include <cstddef>\n\n";
+  file << "alignas(" << AssetFormat::kAssetAlignment
+       << ") extern const unsigned char kEmbeddedAssetBundle[] = {";
+  for (std::size_t i = 0; i < bundle.size(); ++i) {
+    if (i % 16 == 0) { file << "\n  "; }
+    file << static_cast<unsigned>(bundle[i]) << ",";
+  }
+  file << "\n};\n";
+  file << "extern const std::size_t kEmbeddedAssetBundleSize = " << bundle.size() << ";\n";
+  return static_cast<bool>(file);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::string bundlePath{};
+  std::string cppPath{};
+  std::vector<InputAsset> assets{};
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "-o" && i + 1 < argc) {
+      bundlePath = argv[++i];
+    } else if (arg == "--cpp" && i + 1 < argc) {
+      cppPath = argv[++i];
+    } else {
+      InputAsset asset;
+      if (!readAsset(arg, asset)) { return 1; }
+      assets.push_back(std::move(asset));
+    }
+  }
+
+  if (bundlePath.empty()) {
+    std::cerr << "Usage: AssetPacker -o <bundle.pak> [--cpp <embedded.cpp>] <files...>\n";
+    return 1;
+  }
+
+  // The runtime looks assets up with a binary search over the index
+  std::sort(assets.begin(), assets.end(),
+            [](InputAsset const &a, InputAsset const &b) { return a.name < b.name; });
+  for (std::size_t i = 1; i < assets.size(); ++i) {
+    if (assets[i].name == assets[i - 1].name) {
+      std::cerr << "Duplicate asset name " << assets[i].name << "\n";
+      return 1;
+    }
+  }
+
+  std::vector<unsigned char> bundle = buildBundle(assets);
+
+  std::ofstream bundleFile(bundlePath, std::ios::binary);
+  if (!bundleFile.is_open()) {
+    std::cerr << "Failed to write " << bundlePath << "\n";
+    return 1;
+  }
+  bundleFile.write(reinterpret_cast<const char *>(bundle.data()), bundle.size());
+  if (!bundleFile) { return 1; }
+
+  if (!cppPath.empty() && !writeCpp(cppPath, bundle)) { return 1; }
+  return 0;
+}
@@ -0,0 +1,152 @@
+#include "audio.h"
+#include <iostream>
+
+namespace {
+// Mixer channel group tags
+constexpr int kBiteGroup{0};
+constexpr int kDeadGroup{1};
+}  // namespace
+
+MixerAudioSink::MixerAudioSink(AssetBundle const &assets) {
+  // Initialize SDL audio and the mixer
+  if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+    std::cerr << "SDL audio could not initialize.\n";
+    std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+    return;
+  }
+  if (Mix_OpenAudio( 44100, MIX_DEFAULT_FORMAT, 2, 2048 ) < 0) {
+    std::cerr << "SDL_mixer could not initialize.\n";
+    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    return;
+  }
+  _audioOpen = true;
+
+  /*
+   * Reserve a fixed number of voices per effect
+   * so rapid bites can never starve the dead snake sound
+   */
+  Mix_AllocateChannels(2 * kMaxVoicesPerEffect);
+  Mix_GroupChannels(0, kMaxVoicesPerEffect - 1, kBiteGroup);
+  Mix_GroupChannels(kMaxVoicesPerEffect, 2 * kMaxVoicesPerEffect - 1, kDeadGroup);
+
+  /*
+   * Load sound effects straight from the asset bundle memory
+   * The mixer decodes them into its own chunks, so the bundle does not
+   * need to outlive the sink.
+   */
+  _biteSoundPtr = Mix_LoadWAV_RW(assets.openRW(kBiteSoundName), 1);
+  if (nullptr == _biteSoundPtr) {
+    std::cerr << "Failed to load biting sound effect.\n";
+    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
+  }
+
+  _deadSoundPtr = Mix_LoadWAV_RW(assets.openRW(kDeadSoundName), 1);
+  if (nullptr == _deadSoundPtr) {
+    std::cerr << "Failed to load dead snake sound effect.\n";
+    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
+  }
+}
+
+MixerAudioSink::~MixerAudioSink() {
+  Mix_FreeChunk(_deadSoundPtr);
+  Mix_FreeChunk(_biteSoundPtr);
+  if (_audioOpen) {
+    Mix_CloseAudio();
+    Mix_Quit();
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+  }
+}
+
+void MixerAudioSink::play(SoundEffect sound) {
+  Mix_Chunk *chunk = nullptr;
+  int group = -1;
+  switch (sound) {
+    case SoundEffect::kbiteSound:
+       chunk = _biteSoundPtr;
+       group = kBiteGroup;
+       break;
+    case SoundEffect::kdeadSnakeSound:
+       chunk = _deadSoundPtr;
+       group = kDeadGroup;
+       break;
+    default:
+       // Play no sound
+       return;
+  }
+  if (nullptr == chunk) { return; }
+
+  // Voice limiting: once every voice of the effect is busy, restart the oldest one
+  int channel = Mix_GroupAvailable(group);
+  if (channel < 0) { channel = Mix_GroupOldest(group); }
+  if (channel >= 0) { Mix_PlayChannel(channel, chunk, 0); }
+}
+
+bool AudioQueue::push(SoundEffect sound) {
+  std::size_t tail = _tail.load(std::memory_order_relaxed);
+  if (tail - _head.load(std::memory_order_acquire) == kCapacity) {
+    return false;  // Full, the event is dropped
+  }
+  _events[tail & (kCapacity - 1)] = sound;
+  _tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+bool AudioQueue::pop(SoundEffect &sound) {
+  std::size_t head = _head.load(std::memory_order_relaxed);
+  if (head == _tail.load(std::memory_order_acquire)) {
+    return false;  // Empty
+  }
+  sound = _events[head & (kCapacity - 1)];
+  _head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+AudioSystem::AudioSystem(std::unique_ptr<AudioSink> sink)
+    : _sink(sink ? std::move(sink) : std::make_unique<NullAudioSink>()),
+      _pending(SDL_CreateSemaphore(0)) {
+  if (nullptr == _pending) {
+    std::cerr << "Audio semaphore could not be created.\n";
+    std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+  }
+  _worker = std::thread(&AudioSystem::drain_, this);
+}
+
+AudioSystem::~AudioSystem() {
+  _running = false;
+  if (nullptr != _pending) { SDL_SemPost(_pending); }
+  _worker.join();
+  if (nullptr != _pending) { SDL_DestroySemaphore(_pending); }
+}
+
+// Called from the game loop; never waits on the audio device
+void AudioSystem::post(SoundEffect sound) {
+  if (sound != SoundEffect::kNoSound && _queue.push(sound) && nullptr != _pending) {
+    SDL_SemPost(_pending);
+  }
+}
+
+// Audio thread: hand queued events to the sink
+void AudioSystem::drain_() {
+  Uint32 lastPlayed[static_cast<int>(SoundEffect::kNoSound)]{};
+  bool   played[static_cast<int>(SoundEffect::kNoSound)]{};
+  SoundEffect sound;
+
+  while (_running) {
+    while (_queue.pop(sound)) {
+      int index = static_cast<int>(sound);
+      Uint32 now = SDL_GetTicks();
+      // Coalesce repeats that would be indistinguishable anyway
+      if (played[index] && now - lastPlayed[index] < kMinRetriggerInterval) { continue; }
+      played[index] = true;
+      lastPlayed[index] = now;
+      _sink->play(sound);
+    }
+    // Block until post() queues something or the destructor wakes us to stop
+    if (nullptr != _pending) {
+      SDL_SemWait(_pending);
+    } else {
+      SDL_Delay(kMinRetriggerInterval);
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include "SDL.h"
+#include "SDL_mixer.h"
+#include "asset_bundle.h"
+
+// Define SoundEffect Type
+enum class SoundEffect { kbiteSound, kdeadSnakeSound, kNoSound };
+
+// Destination of sound effects, implemented per audio backend
+class AudioSink {
+ public:
+  virtual ~AudioSink() = default;
+  virtual void play(SoundEffect sound) = 0;
+};
+
+// Plays sound effects through SDL_mixer
+class MixerAudioSink : public AudioSink {
+ public:
+  // Constructor
+  explicit MixerAudioSink(AssetBundle const &assets);
+
+  // Destructor
+  ~MixerAudioSink() override;
+
+  // Owns the mixer device, so it can neither be copied nor moved
+  MixerAudioSink(const MixerAudioSink &) = delete;
+  MixerAudioSink &operator=(const MixerAudioSink &) = delete;
+
+  // Public methods
+  void play(SoundEffect sound) override;
+
+  // Public data
+  const std::string kBiteSoundName{"biting-sound.wav"};
+  const std::string kDeadSoundName{"dead.wav"};
+  static constexpr int kMaxVoicesPerEffect{4};  // Mixer channels reserved per effect
+
+ private:
+  Mix_Chunk *_biteSoundPtr{nullptr};   // To store biting sound effect
+  Mix_Chunk *_deadSoundPtr{nullptr};   // To store dead snake sound effect
+  bool       _audioOpen{false};
+};
+
+// Discards every sound effect, for headless runs
+class NullAudioSink : public AudioSink {
+ public:
+  void play(SoundEffect) override {}
+};
+
+/*
+ * Lock-free single producer / single consumer ring buffer of sound events
+ * The game loop is the only producer and the audio thread the only consumer.
+ */
+class AudioQueue {
+ public:
+  bool push(SoundEffect sound);
+  bool pop(SoundEffect &sound);
+
+  static constexpr std::size_t kCapacity{64};
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "Index masking needs a power of two capacity");
+
+ private:
+  std::array<SoundEffect, kCapacity> _events{};
+  std::atomic<std::size_t> _head{0};  // Next slot to read, owned by the consumer
+  std::atomic<std::size_t> _tail{0};  // Next slot to write, owned by the producer
+};
+
+/*
+ * Decouples the simulation from the audio device
+ * post() never blocks: events go into the AudioQueue and a dedicated thread
+ * hands them to the sink. Rapid repeats of the same effect are coalesced.
+ * The thread sleeps on a semaphore while the queue is empty, so an idle
+ * game costs no audio wakeups.
+ */
+class AudioSystem {
+ public:
+  // Constructor
+  explicit AudioSystem(std::unique_ptr<AudioSink> sink);
+
+  // Destructor
+  ~AudioSystem();
+
+  AudioSystem(const AudioSystem &) = delete;
+  AudioSystem &operator=(const AudioSystem &) = delete;
+
+  // Public methods
+  void post(SoundEffect sound);
+
+  // Public data
+  static constexpr Uint32 kMinRetriggerInterval{40};  // In ms, per effect
+
+ private:
+  // Private methods
+  void drain_();
+
+  // Private data
+  std::unique_ptr<AudioSink> _sink;
+  AudioQueue                 _queue;
+  SDL_sem                   *_pending;       // Posted once per queued event and on shutdown
+  std::atomic<bool>          _running{true};
+  std::thread                _worker;
+};
+
+#endif
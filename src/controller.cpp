@@ -3,62 +3,132 @@
 #include "SDL.h"
 #include "snake.h"
 
-void Controller::changeDirection_(Snake &snake, Snake::Direction input,
-                                 Snake::Direction opposite) const {
-  /*
-   * Here the opposite direction is used to prevent the snake
-   * to move into itself if it's size is more than 1
-   */
-  if (snake.direction != opposite || snake.size == 1) {
-    snake.direction = input;
-  }
-  return;
-}
+// Steer with the arrow keys or with w, a, s and d
+Controller::Controller()
+    : _keys{ControlKeys{SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT},
+            ControlKeys{SDLK_w, SDLK_s, SDLK_a, SDLK_d}} {}
+
+// Steer with a single key set, e.g. for one of several boards sharing a keyboard
+Controller::Controller(ControlKeys const &keys) : _keys{keys} {}
 
 /*
  * Define game controls
  * If user closes the game window, set running as false to exit the game loop
- * If user presses left arrow key or 'a' change the snake direction to left
- * If user presses right arrow key or 'd' change the snake direction to right
- * If user presses up arrow key or 'w' change the snake direction to up
- * If user presses down arrow key or 's' change the snake direction to down
+ * If user presses a left key (by default left arrow or 'a') change the snake direction to left
+ * If user presses a right key (by default right arrow or 'd') change the snake direction to right
+ * If user presses an up key (by default up arrow or 'w') change the snake direction to up
+ * If user presses a down key (by default down arrow or 's') change the snake direction to down
+ * If user presses p, pause or resume the game
+ * If user presses r, request a rewind (only honoured in practice mode)
  * If user presses q, set running as false to exit the game loop
+ * If the window gets minimized or hidden, the game is idle until it is shown again
+ * If the window gets shown, restored or uncovered, request a redraw of the current frame
+ *
+ * Returns the requested direction, if any, instead of applying it, so the
+ * same controls can drive a local snake or a tick-indexed input stream.
  */
-void Controller::handleInput(bool &running, Snake &snake) const {
+PlayerInput Controller::handleEvent_(SDL_Event const &e, bool &running) {
+  if (e.type == SDL_QUIT) {
+    running = false;
+  } else if (e.type == SDL_WINDOWEVENT) {
+    switch (e.window.event) {
+      case SDL_WINDOWEVENT_HIDDEN:
+      case SDL_WINDOWEVENT_MINIMIZED:
+        _hidden = true;
+        break;
+
+      case SDL_WINDOWEVENT_SHOWN:
+      case SDL_WINDOWEVENT_RESTORED:
+        _hidden = false;
+        _redraw = true;
+        break;
+
+      case SDL_WINDOWEVENT_EXPOSED:
+        _redraw = true;
+        break;
+    }
+  } else if (e.type == SDL_KEYDOWN) {
+    switch (e.key.keysym.sym) {
+      case SDLK_p:
+        _paused = !_paused;
+        break;
+
+      case SDLK_q:
+        running = false;
+        break;
+    }
+
+    // Steering and rewinding are ignored while the game is paused
+    if (_paused) { return kNoInput; }
+
+    SDL_Keycode key = e.key.keysym.sym;
+    if (key == SDLK_r) { _rewind = true; }
+
+    for (ControlKeys const &keys : _keys) {
+      if (key == keys.up)    { return encodeDirection(Snake::Direction::kUp); }
+      if (key == keys.down)  { return encodeDirection(Snake::Direction::kDown); }
+      if (key == keys.left)  { return encodeDirection(Snake::Direction::kLeft); }
+      if (key == keys.right) { return encodeDirection(Snake::Direction::kRight); }
+    }
+  }
+  return kNoInput;
+}
+
+void Controller::handleInput(bool &running, Snake &snake) {
   SDL_Event e;
   while (SDL_PollEvent(&e)) {
-    if (e.type == SDL_QUIT) {
-      running = false;
-    } else if (e.type == SDL_KEYDOWN) {
-      switch (e.key.keysym.sym) {
-        case SDLK_UP:
-        case SDLK_w:
-          changeDirection_(snake, Snake::Direction::kUp,
-                           Snake::Direction::kDown);
-          break;
-
-        case SDLK_DOWN:
-        case SDLK_s:
-          changeDirection_(snake, Snake::Direction::kDown,
-                           Snake::Direction::kUp);
-          break;
-
-        case SDLK_LEFT:
-        case SDLK_a:
-          changeDirection_(snake, Snake::Direction::kLeft,
-                           Snake::Direction::kRight);
-          break;
-
-        case SDLK_RIGHT:
-        case SDLK_d:
-          changeDirection_(snake, Snake::Direction::kRight,
-                           Snake::Direction::kLeft);
-          break;
-
-        case SDLK_q:
-          running = false;
-          break;
-      }
-    }
+    handleEvent(e, running, snake);
+  }
+}
+
+// Apply a single event, for callers that run the event pump themselves
+void Controller::handleEvent(SDL_Event const &e, bool &running, Snake &snake) {
+  PlayerInput input = handleEvent_(e, running);
+  if (input != kNoInput) { snake.steer(decodeDirection(input)); }
+}
+
+/*
+ * Sleep until an event arrives or the timeout expires, then handle
+ * everything that is pending. Used while idle so the game does not
+ * spin the CPU when nothing can change on screen.
+ */
+void Controller::waitForInput(bool &running, Snake &snake, int timeoutMs) {
+  SDL_Event e;
+  if (SDL_WaitEventTimeout(&e, timeoutMs)) {
+    handleEvent(e, running, snake);
+    handleInput(running, snake);
   }
-}
\ No newline at end of file
+}
+
+/*
+ * Collect the input for the next simulation tick without applying it
+ * If several direction keys were pressed, the last one wins.
+ */
+PlayerInput Controller::sampleInput(bool &running) {
+  PlayerInput sampled = kNoInput;
+  SDL_Event e;
+  while (SDL_PollEvent(&e)) {
+    PlayerInput input = handleEvent_(e, running);
+    if (input != kNoInput) { sampled = input; }
+  }
+  return sampled;
+}
+
+// Whether the game loop has nothing to simulate or show
+bool Controller::idle() const {
+  return _paused || _hidden;
+}
+
+// Returns whether the window needs its frame drawn again, never while it is hidden
+bool Controller::redrawRequested() {
+  bool requested = _redraw && !_hidden;
+  _redraw = false;
+  return requested;
+}
+
+// Returns whether a rewind was requested since the last call
+bool Controller::rewindRequested() {
+  bool requested = _rewind;
+  _rewind = false;
+  return requested;
+}
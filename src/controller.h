@@ -1,15 +1,42 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
+#include <vector>
+#include "SDL.h"
+#include "input.h"
 #include "snake.h"
 
+// Keys that steer a snake
+struct ControlKeys {
+  SDL_Keycode up;
+  SDL_Keycode down;
+  SDL_Keycode left;
+  SDL_Keycode right;
+};
+
 class Controller {
  public:
-  void handleInput(bool &running, Snake &snake) const;
+  // Constructors
+  Controller();
+  explicit Controller(ControlKeys const &keys);
+
+  // Public methods
+  void handleInput(bool &running, Snake &snake);
+  void handleEvent(SDL_Event const &e, bool &running, Snake &snake);
+  void waitForInput(bool &running, Snake &snake, int timeoutMs);
+  PlayerInput sampleInput(bool &running);
+  bool idle() const;
+  bool rewindRequested();
+  bool redrawRequested();
 
  private:
-  void changeDirection_(Snake &snake, Snake::Direction input,
-                        Snake::Direction opposite) const;
+  PlayerInput handleEvent_(SDL_Event const &e, bool &running);
+
+  std::vector<ControlKeys> _keys;  // Any of these key sets steers
+  bool _paused{false};  // Toggled by the player
+  bool _hidden{false};  // Window is minimized or hidden
+  bool _rewind{false};  // Rewind was requested and not yet handled
+  bool _redraw{false};  // Window content was lost, e.g. uncovered while paused
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,92 +1,374 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <random>
+#include <utility>
 #include "game.h"
 #include "SDL.h"
 
 Game::Game(std::size_t gridWidth, std::size_t gridHeight,
-           Controller &&controller, Renderer &&renderer)
-    : _snake(gridWidth, gridHeight),
+           Controller &&controller, std::unique_ptr<RenderBackend> renderer,
+           std::shared_ptr<AudioSystem> audio)
+    : _gridWidth(gridWidth),
+      _gridHeight(gridHeight),
+      _snake(gridWidth, gridHeight),
       _gController(std::move(controller)),
       _gRenderer(std::move(renderer)),
-      _engine(_dev()),
-      /*
-       * Setting the range from 1 to grid dimension - 1
-       * so that the food does not get generated outside the grid
-       */
-      _randomW(1, static_cast<int>(gridWidth)-1),  
-      _randomH(1, static_cast<int>(gridHeight)-1) {
+      _audio(std::move(audio)),
+      _governor(static_cast<double>(kTargetFrameDuration)),
+      _random(std::random_device{}()) {
   placeFood_();
+  _nextSpawnAt = kPowerUpSpawnInterval;
+  schedule_(_spawnTimer, _nextSpawnAt, Event::kSpawnPowerUp);
 }
 
-// Implements Main Game Loop
+/*
+ * Implements Main Game Loop
+ * The simulation advances in fixed ticks of kTargetFrameDuration, independent
+ * of how long rendering takes. The governor decides how often and how a
+ * frame is rendered, based on measured costs. While the game is paused or
+ * the window is hidden the loop blocks on the event queue instead.
+ */
 void Game::run_() {
-  Uint32 titleTimestamp = SDL_GetTicks();
-  Uint32 frameStart;
-  Uint32 frameEnd;
-  Uint32 frameDuration;
-  bool running = true;
+  const double tickDuration = static_cast<double>(kTargetFrameDuration);
+  const double countsPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+  auto elapsedMs = [countsPerMs](Uint64 since) {
+    return (SDL_GetPerformanceCounter() - since) / countsPerMs;
+  };
+
+  Uint64 previous = SDL_GetPerformanceCounter();
+  double lag = 0.0;                 // Simulation time owed, in ms
+  _titleTimestamp = SDL_GetTicks();
+  _running = true;
+
+  while (_running) {
+    if (_gController.idle()) {
+      // Near zero CPU: sleep until an event arrives
+      _gController.waitForInput(_running, _snake, kIdleWaitTimeout);
+      if (_gController.redrawRequested()) { present(true); }  // E.g. uncovered while paused
+      previous = SDL_GetPerformanceCounter();  // Do not catch up on time spent idle
+      lag = 0.0;
+      continue;
+    }
 
-  while (running) {
-    frameStart = SDL_GetTicks();
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    lag += (frameStart - previous) / countsPerMs;
+    previous = frameStart;
 
     // Input, Update, Render - the main game loop.
-    _gController.handleInput(running, _snake);
-    update_(running);
-    _gRenderer.render(_snake, _food);
+    _gController.handleInput(_running, _snake);
+
+    std::size_t ticks = 0;
+    while (lag >= tickDuration && ticks < kMaxCatchUpTicks) {
+      tick_();
+      lag -= tickDuration;
+      ++ticks;
+    }
+    if (ticks == kMaxCatchUpTicks) {
+      lag = 0.0;  // Too far behind, drop the backlog instead of spiralling
+    }
 
-    frameEnd = SDL_GetTicks();
+    present();
 
     /*
-     * Keep track of how long each frame loop through 
-     * the input/update/render cycle
+     * Sleep for whatever is left until the next simulation tick is due,
+     * so input is polled once per tick without busy waiting
      */
-    frameDuration = frameEnd - frameStart;
+    double remaining = tickDuration - lag - elapsedMs(frameStart);
+    if (remaining >= 1.0) {
+      SDL_Delay(static_cast<Uint32>(remaining));
+    }
+  }
+}
 
-    // After every second, update the window title.
-    if (frameEnd - titleTimestamp >= 1000) {
-      if (_disableLeaderBoardFeature) {
-        _gRenderer.updateWindowTitle(_playerName, _score, false);
-      } else {
-        _gRenderer.updateWindowTitle(_playerName, _score, true, _highScore);
-      }
-      titleTimestamp = frameEnd;
+// Advance the simulation by one tick, measuring its cost for the governor
+void Game::tick_() {
+  const double countsPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+  Uint64 tickStart = SDL_GetPerformanceCounter();
+  update_(_running);
+  _governor.recordTick((SDL_GetPerformanceCounter() - tickStart) / countsPerMs);
+  ++_ticksSinceRender;
+}
+
+/*
+ * Play a game as fast as the backend renders, e.g. for headless recording
+ * Nobody is at the keyboard: a scripted pilot steers at random and every
+ * tick is rendered, without pacing to the display rate. Ends when the
+ * snake dies, after maxFrames frames or on SDL_QUIT (e.g. Ctrl+C), and
+ * returns the number of frames rendered. Skips the banner and prompts and
+ * leaves the scoreboard untouched.
+ */
+std::size_t Game::runUnattended(std::string const &name, std::size_t maxFrames) {
+  startHosted(name);
+  Random pilot(_random.next());
+
+  std::size_t frames = 0;
+  while (_running && _state != State::kGameOver && frames < maxFrames) {
+    _gController.handleInput(_running, _snake);
+    if (pilot.uniform(0, 7) == 0) {
+      _snake.steer(static_cast<Snake::Direction>(pilot.uniform(0, 3)));
     }
+    tick_();
+    _gRenderer->render(_snake, _food, _powerUps, RenderBackend::RenderPath::kIncremental);
+    ++frames;
+  }
+  displayResult_();
+  return frames;
+}
 
-    /*
-     * If the time for this frame is too small (i.e. frameDuration is
-     * smaller than the target ms_per_frame), delay the loop to
-     * achieve the correct frame rate.
-     */
-    if (frameDuration < kTargetFrameDuration) {
-      SDL_Delay(kTargetFrameDuration - frameDuration);
+/*
+ * Prepare to be driven by a host instead of run()
+ * Hosted sessions skip the console banner and prompts and do not use the
+ * scoreboard, the host reports their results.
+ */
+void Game::startHosted(std::string const &name) {
+  _playerName = name;
+  _disableLeaderBoardFeature = true;
+  _running = true;
+  _titleTimestamp = SDL_GetTicks();
+}
+
+/*
+ * Hand one event to this session's controller
+ * For hosts that run a single event pump for several sessions.
+ */
+void Game::handleEvent(SDL_Event const &e) {
+  _gController.handleEvent(e, _running, _snake);
+}
+
+// Advance a hosted session by one tick, paused and hidden sessions stand still
+void Game::step() {
+  if (_running && !_gController.idle()) { tick_(); }
+}
+
+/*
+ * Render the board if the governor asks for a frame, or always with
+ * redraw, e.g. when it shares a window with other boards. Then update
+ * the window title once a second.
+ */
+void Game::present(bool redraw) {
+  if (redraw || _ticksSinceRender >= _governor.renderInterval()) {
+    const double countsPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    Uint64 renderStart = SDL_GetPerformanceCounter();
+    _gRenderer->render(_snake, _food, _powerUps, _governor.renderPath());
+    _governor.recordRender((SDL_GetPerformanceCounter() - renderStart) / countsPerMs);
+    _ticksSinceRender = 0;
+  }
+  _governor.evaluate();
+
+  // After every second, update the window title.
+  Uint32 now = SDL_GetTicks();
+  if (now - _titleTimestamp >= 1000) {
+    if (_disableLeaderBoardFeature) {
+      _gRenderer->updateWindowTitle(_playerName, _score, false);
+    } else {
+      _gRenderer->updateWindowTitle(_playerName, _score, true, _highScore);
     }
+    _titleTimestamp = now;
   }
 }
 
+bool Game::finished() const {
+  return !_running;
+}
+
+// Paused or hidden, the host need not tick or draw this session
+bool Game::idle() const {
+  return _gController.idle();
+}
+
+// Whether the board lost its content, e.g. uncovered while paused
+bool Game::redrawRequested() {
+  return _gController.redrawRequested();
+}
+
+Uint32 Game::windowId() const {
+  return _gRenderer->windowId();
+}
+
 void Game::placeFood_() {
   int x, y;
   while (true) {
-    x = _randomW(_engine);
-    y = _randomH(_engine);
+    SDL_Point cell = randomCell_();
+    x = cell.x;
+    y = cell.y;
     /*
      * Check that the location is not occupied by a snake item 
-     * before placing food.
+     * or a power-up before placing food.
      */
-    if (!_snake.snakeCell(x, y)) {
+    if (!_snake.snakeCell(x, y) && !(_food.x == x && _food.y == y) && freeCell_(x, y)) {
       _food.x = x;
       _food.y = y;
+      break;
+    }
+  }
+
+  // Food that is not eaten in time moves elsewhere
+  _foodExpiresAt = _tick + kFoodLifetime;
+  schedule_(_foodTimer, _foodExpiresAt, Event::kFoodExpired);
+}
+
+/*
+ * Pick a random cell that is not a wall or portal
+ * On a level this draws from the precomputed free-cell set, so it never
+ * has to retry because of walls, however many there are.
+ */
+SDL_Point Game::randomCell_() {
+  if (nullptr != _level) {
+    return _level->freeCell(static_cast<std::size_t>(
+        _random.uniform(0, static_cast<int>(_level->freeCellCount()) - 1)));
+  }
+  /*
+   * Setting the range from 1 to grid dimension - 1
+   * so that nothing gets generated outside the grid
+   */
+  return SDL_Point{_random.uniform(1, static_cast<int>(_gridWidth) - 1),
+                   _random.uniform(1, static_cast<int>(_gridHeight) - 1)};
+}
+
+// Whether no power-up lies on the cell
+bool Game::freeCell_(int x, int y) const {
+  for (PowerUp const &powerUp : _powerUps) {
+    if (powerUp.active && powerUp.position.x == x && powerUp.position.y == y) { return false; }
+  }
+  return true;
+}
+
+// (Re)arm a timer, cancelling its previous deadline in O(1)
+void Game::schedule_(TimingWheel::TimerId &timer, std::uint32_t deadline, Event event,
+                     std::uint32_t index) {
+  _timers.cancel(timer);
+  timer = _timers.schedule(deadline, (static_cast<std::uint32_t>(event) << 16) | index);
+}
+
+// Advance the timing wheel by one tick and act on everything that came due
+void Game::handleEvents_() {
+  _expiredEvents.clear();
+  _timers.advance(_expiredEvents);
+
+  for (std::uint32_t payload : _expiredEvents) {
+    std::uint32_t index = payload & 0xFFFFu;
+    switch (static_cast<Event>(payload >> 16)) {
+      case Event::kFoodExpired:
+        placeFood_();
+        break;
+
+      case Event::kSpawnPowerUp:
+        spawnPowerUp_();
+        _nextSpawnAt = _tick + kPowerUpSpawnInterval;
+        schedule_(_spawnTimer, _nextSpawnAt, Event::kSpawnPowerUp);
+        break;
+
+      case Event::kPowerUpExpired:
+        _powerUps[index].active = false;
+        break;
+
+      case Event::kBoostEnded:
+        _snake.speed -= kBoostSpeed;
+        _boostEndsAt = 0;
+        break;
+    }
+  }
+}
+
+// Drop a random power-up on a free cell, if there is room for one
+void Game::spawnPowerUp_() {
+  constexpr int kPlacementAttempts{16};
+  for (std::size_t i = 0; i < _powerUps.size(); ++i) {
+    PowerUp &powerUp = _powerUps[i];
+    if (powerUp.active) { continue; }
+
+    for (int attempt = 0; attempt < kPlacementAttempts; ++attempt) {
+      SDL_Point cell = randomCell_();
+      int x = cell.x;
+      int y = cell.y;
+      if (_snake.snakeCell(x, y) || (_food.x == x && _food.y == y) || !freeCell_(x, y)) {
+        continue;
+      }
+      powerUp.type      = static_cast<PowerUp::Type>(_random.uniform(0, 2));
+      powerUp.active    = true;
+      powerUp.position  = SDL_Point{x, y};
+      powerUp.expiresAt = _tick + kPowerUpLifetime;
+      schedule_(_powerUpTimers[i], powerUp.expiresAt, Event::kPowerUpExpired,
+                static_cast<std::uint32_t>(i));
       return;
     }
+    return;  // Board too crowded, try again at the next spawn
+  }
+}
+
+// Apply the power-up under the snake's head, if any
+void Game::collectPowerUps_(int x, int y) {
+  for (std::size_t i = 0; i < _powerUps.size(); ++i) {
+    PowerUp &powerUp = _powerUps[i];
+    if (!powerUp.active || powerUp.position.x != x || powerUp.position.y != y) { continue; }
+
+    _audio->post(SoundEffect::kbiteSound);
+    switch (powerUp.type) {
+      case PowerUp::Type::kBonus:
+        _score += kBonusPoints;
+        break;
+
+      case PowerUp::Type::kSpeedBoost:
+        // Picking up another boost extends the running one
+        if (_boostEndsAt == 0) { _snake.speed += kBoostSpeed; }
+        _boostEndsAt = _tick + kBoostDuration;
+        schedule_(_boostTimer, _boostEndsAt, Event::kBoostEnded);
+        break;
+
+      case PowerUp::Type::kShrink:
+        _snake.shrinkBody(kShrinkSegments);
+        break;
+    }
+    powerUp.active = false;
+    _timers.cancel(_powerUpTimers[i]);
+  }
+}
+
+/*
+ * Rebuild the timing wheel from the deadlines kept in the game state,
+ * used after restoring a snapshot
+ */
+void Game::rescheduleTimers_() {
+  _timers.reset(_tick);
+  _foodTimer  = _timers.schedule(_foodExpiresAt, static_cast<std::uint32_t>(Event::kFoodExpired) << 16);
+  _spawnTimer = _timers.schedule(_nextSpawnAt, static_cast<std::uint32_t>(Event::kSpawnPowerUp) << 16);
+  _boostTimer = TimingWheel::kInvalidTimer;
+  if (_boostEndsAt != 0) {
+    _boostTimer = _timers.schedule(_boostEndsAt, static_cast<std::uint32_t>(Event::kBoostEnded) << 16);
+  }
+  for (std::size_t i = 0; i < _powerUps.size(); ++i) {
+    _powerUpTimers[i] = TimingWheel::kInvalidTimer;
+    if (_powerUps[i].active) {
+      _powerUpTimers[i] = _timers.schedule(
+          _powerUps[i].expiresAt,
+          (static_cast<std::uint32_t>(Event::kPowerUpExpired) << 16) | static_cast<std::uint32_t>(i));
+    }
   }
 }
 
 void Game::update_(bool &running) {
+  if (_practiceMode && _gController.rewindRequested()) {
+    rewind_();
+    return;
+  }
+
+  /*
+   * Once the snake is dead keep the loop (and with it rendering and input)
+   * alive for a short while so the dead snake sound can finish playing
+   */
+  if (_state == State::kGameOver) {
+    // In practice mode the player may still rewind, so wait for 'q'
+    if (!_practiceMode && SDL_GetTicks() - _gameOverTimestamp >= kGameOverDuration) {
+      running = false;
+    }
+    return;
+  }
+
   if (!_snake.alive) {
-    _gRenderer.play(Renderer::SoundEffect::kdeadSnakeSound);
-    running = false;
-    SDL_Delay(1000); // Adding 1 sec delay to prevent a quick exit
-                     // so that dead snake sound can finish playing
+    _audio->post(SoundEffect::kdeadSnakeSound);
+    _state = State::kGameOver;
+    _gameOverTimestamp = SDL_GetTicks();
     return;
   }
 
@@ -97,13 +379,113 @@ void Game::update_(bool &running) {
 
   // Check if there's food over here
   if (_food.x == newX && _food.y == newY) {
-    _gRenderer.play(Renderer::SoundEffect::kbiteSound);
+    _audio->post(SoundEffect::kbiteSound);
     _score += 10;
     placeFood_();
     // Grow snake and increase speed.
     _snake.growBody();
     _snake.speed += 0.02;
   }
+
+  collectPowerUps_(newX, newY);
+
+  ++_tick;
+  handleEvents_();
+  if (_practiceMode && !saveSnapshot(_history->record())) {
+    _history->clear();  // Snake outgrew the snapshot layout, rewinding is no longer possible
+  }
+}
+
+void Game::rewind_() {
+  GameSnapshot const *snapshot = _history ? _history->rewind(kRewindTicks) : nullptr;
+  if (nullptr != snapshot) {
+    restoreSnapshot(*snapshot);
+    _state = State::kPlaying;
+  }
+}
+
+/*
+ * Practice mode records the last few seconds of play so the player can
+ * rewind with 'r'. Practice scores are not added to the scoreboard.
+ */
+void Game::setPracticeMode(bool enabled) {
+  _practiceMode = enabled;
+  if (!_practiceMode) {
+    _history.reset();
+    return;
+  }
+  if (!_history) { _history = std::make_unique<SnapshotHistory>(kRewindTicks + 1); }
+  _history->clear();
+  if (!saveSnapshot(_history->record())) {
+    _history->clear();
+  }
+}
+
+/*
+ * Play on a level instead of the open board, the grid must match its size
+ * The snake starts on the spawn point farthest from any wall, heading
+ * towards the most open neighbouring cell.
+ */
+void Game::setLevel(Level const &level) {
+  _level = &level;
+  _snake.setLevel(_level);
+  _gRenderer->setLevel(_level);
+
+  SDL_Point spawn = level.spawn(0);
+  for (std::size_t i = 1; i < level.spawnCount(); ++i) {
+    SDL_Point candidate = level.spawn(i);
+    if (level.clearance(candidate.x, candidate.y) > level.clearance(spawn.x, spawn.y)) {
+      spawn = candidate;
+    }
+  }
+  _snake.headX = static_cast<float>(spawn.x);
+  _snake.headY = static_cast<float>(spawn.y);
+
+  int width = level.width();
+  int height = level.height();
+  std::pair<Snake::Direction, SDL_Point> neighbours[]{
+      {Snake::Direction::kUp,    SDL_Point{spawn.x, (spawn.y + height - 1) % height}},
+      {Snake::Direction::kDown,  SDL_Point{spawn.x, (spawn.y + 1) % height}},
+      {Snake::Direction::kLeft,  SDL_Point{(spawn.x + width - 1) % width, spawn.y}},
+      {Snake::Direction::kRight, SDL_Point{(spawn.x + 1) % width, spawn.y}}};
+  std::uint16_t bestClearance = 0;
+  for (auto const &neighbour : neighbours) {
+    std::uint16_t clearance = level.clearance(neighbour.second.x, neighbour.second.y);
+    if (clearance > bestClearance) {
+      bestClearance = clearance;
+      _snake.direction = neighbour.first;
+    }
+  }
+
+  // The food may have been placed before the walls were known
+  placeFood_();
+  setPracticeMode(_practiceMode);
+}
+
+// Capture the complete simulation state
+bool Game::saveSnapshot(GameSnapshot &snapshot) const {
+  snapshot.tick   = _tick;
+  snapshot.score  = _score;
+  snapshot.food   = _food;
+  snapshot.random = _random;
+  snapshot.powerUps      = _powerUps;
+  snapshot.foodExpiresAt = _foodExpiresAt;
+  snapshot.nextSpawnAt   = _nextSpawnAt;
+  snapshot.boostEndsAt   = _boostEndsAt;
+  return _snake.save(snapshot.snake);
+}
+
+void Game::restoreSnapshot(GameSnapshot const &snapshot) {
+  _tick   = snapshot.tick;
+  _score  = snapshot.score;
+  _food   = snapshot.food;
+  _random = snapshot.random;
+  _powerUps      = snapshot.powerUps;
+  _foodExpiresAt = snapshot.foodExpiresAt;
+  _nextSpawnAt   = snapshot.nextSpawnAt;
+  _boostEndsAt   = snapshot.boostEndsAt;
+  _snake.restore(snapshot.snake);
+  rescheduleTimers_();
 }
 
 // Getters definition
@@ -194,6 +576,7 @@ void Game::getPlayerDetails_() {
         std::cout << "\nNamaste " << _playerName << "\U0001F64F  Welcome to the Classic Snake Game!!" << "\n";
         std::cout << "Since you are a new player, allow me to introduce you to the game controls!" << "\n";
         std::cout << "* To control the snake, you can either use the arrow keys or the 'w','a','s','d' keys." << "\n";
+        std::cout << "* To pause or resume the game, press 'p'." << "\n";
         std::cout << "* To quit the game, you can either close the game window or press 'q'" << "\n\n";
         std::cout << "Current Scoreboard Leader is " << _topScorer << " with a score of " << _highScore << "\n"; 
         std::cout << "When you are ready to play, press 's' and enter to start the game!!!" << std::endl;
@@ -219,6 +602,7 @@ void Game::getPlayerDetails_() {
        */
       std::cout << "\nNamaste " << _playerName << "\U0001F64F  Welcome to the Classic Snake Game!!" << "\n";
       std::cout << "* To control the snake, you can either use the arrow keys or the 'w','a','s','d' keys." << "\n";
+      std::cout << "* To pause or resume the game, press 'p'." << "\n";
       std::cout << "* To quit the game, you can either close the game window or press 'q'" << "\n\n";
       std::cout << "When you are ready to play, press 's' to start the game!!!" << std::endl;
       std::cin >> pResponse;
@@ -316,7 +700,7 @@ void Game::run() {
   displayResult_();
   if (!_disableLeaderBoardFeature) {  // Display scoreboard only if the scoreboard.txt file could be
                                       // properly read. Otherwise disable the leaderboard feature
-    updateScoreBoard_();
+    if (!_practiceMode) { updateScoreBoard_(); }
     displayScoreBoard();
   }
 }
\ No newline at end of file
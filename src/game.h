@@ -1,25 +1,49 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include <random>
 #include <string>
 #include <unordered_map>
 #include <thread>
 #include <future>
+#include <memory>
 #include "SDL.h"
+#include "asset_bundle.h"
+#include "audio.h"
 #include "controller.h"
-#include "renderer.h"
+#include "governor.h"
+#include "level.h"
+#include "powerup.h"
+#include "random.h"
+#include "render_backend.h"
 #include "snake.h"
+#include "snapshot.h"
+#include "timing_wheel.h"
 
 class Game {
  public:
   // Constructor
   Game(std::size_t gridWidth, std::size_t gridHeight,
-       Controller &&controller, Renderer &&renderer);
+       Controller &&controller, std::unique_ptr<RenderBackend> renderer,
+       std::shared_ptr<AudioSystem> audio);
 
   // Public Methods
   void displayScoreBoard();
   void run();
+  std::size_t runUnattended(std::string const &name, std::size_t maxFrames);
+  void setPracticeMode(bool enabled);
+  void setLevel(Level const &level);
+
+  // Driving the session from a host that runs one event pump for several sessions
+  void startHosted(std::string const &name);
+  void handleEvent(SDL_Event const &e);
+  void step();
+  void present(bool redraw = false);
+  bool finished() const;
+  bool idle() const;
+  bool redrawRequested();
+  Uint32 windowId() const;
+  bool saveSnapshot(GameSnapshot &snapshot) const;
+  void restoreSnapshot(GameSnapshot const &snapshot);
   
   // Getters
   int getScore() const;
@@ -27,11 +51,30 @@ class Game {
   std::string getPlayerName() const;
 
   // Public Data
-  const std::string kScoreBoardPath{"../assets/scoreboard.txt"};
+  const std::string kScoreBoardPath{AssetBundle::dataPath("scoreboard.txt")};
   const std::size_t kFramesPerSecond{60};
   const std::size_t kTargetFrameDuration{1000 / kFramesPerSecond};
+  const Uint32      kGameOverDuration{1000};  // In ms, lets the dead snake sound finish
+  const int         kIdleWaitTimeout{250};    // In ms, longest event wait while idle
+  const std::size_t kMaxCatchUpTicks{5};      // Simulation ticks allowed per loop iteration
+  const std::size_t kRewindTicks{5 * kFramesPerSecond};  // How far 'r' rewinds in practice mode
+
+  // Timed gameplay, durations in simulation ticks
+  // Uneaten food moves elsewhere after kFoodLifetime
+  const std::uint32_t kFoodLifetime{static_cast<std::uint32_t>(10 * kFramesPerSecond)};
+  const std::uint32_t kPowerUpLifetime{static_cast<std::uint32_t>(6 * kFramesPerSecond)};
+  const std::uint32_t kPowerUpSpawnInterval{static_cast<std::uint32_t>(8 * kFramesPerSecond)};
+  const std::uint32_t kBoostDuration{static_cast<std::uint32_t>(5 * kFramesPerSecond)};
+  const float         kBoostSpeed{0.05f};   // Added to the snake speed while boosted
+  const int           kBonusPoints{30};
+  const int           kShrinkSegments{3};
 
  private:
+  // Define game state type
+  enum class State { kPlaying, kGameOver };
+
+  // Define timed event type, stored in the timing wheel payload with an item index
+  enum class Event : std::uint32_t { kFoodExpired, kSpawnPowerUp, kPowerUpExpired, kBoostEnded };
 
   // Private methods
   void placeFood_();
@@ -42,25 +85,59 @@ class Game {
   void getPlayerDetails_();
   void readScoreBoard_();
   void run_();
+  void tick_();
   void displayResult_();
+  void rewind_();
+  void schedule_(TimingWheel::TimerId &timer, std::uint32_t deadline, Event event,
+                 std::uint32_t index = 0);
+  void handleEvents_();
+  void spawnPowerUp_();
+  void collectPowerUps_(int x, int y);
+  void rescheduleTimers_();
+  bool freeCell_(int x, int y) const;
+  SDL_Point randomCell_();
   bool isValidScore_(std::string const &score);
 
   // Private data
+  std::size_t  _gridWidth;
+  std::size_t  _gridHeight;
   Snake        _snake;
   Controller   _gController;
-  Renderer     _gRenderer;
-  SDL_Point    _food;
+  std::unique_ptr<RenderBackend> _gRenderer;
+  std::shared_ptr<AudioSystem> _audio;  // May be shared by sessions driven from one thread
+  PerformanceGovernor _governor;
+  State        _state{State::kPlaying};
+  Uint32       _gameOverTimestamp{0};
+  bool         _running{true};
+  std::size_t  _ticksSinceRender{0};
+  Uint32       _titleTimestamp{0};  // When the window title was last updated
+  SDL_Point    _food{-1, -1};  // Off the board until the first placement
+  Level const *_level{nullptr};  // Walls and portals, none on the open board
   int          _score{0};
   int          _highScore{0};
   std::string  _playerName{};
   std::string  _topScorer{};
   bool         _disableLeaderBoardFeature{false};
+  bool         _practiceMode{false};
+  Uint32       _tick{0};        // Simulation ticks since the start of the game
+
+  // For randomly placing food, deterministic so it can be snapshotted
+  Random       _random;
+
+  // Per-tick snapshots for rewinding, only allocated in practice mode
+  std::unique_ptr<SnapshotHistory> _history{};
 
-  // For randomly placing food 
-  std::random_device _dev;
-  std::mt19937    _engine;
-  std::uniform_int_distribution<int> _randomW;
-  std::uniform_int_distribution<int> _randomH;
+  // Timed events, the wheel's current tick always equals _tick
+  TimingWheel                _timers;
+  std::vector<std::uint32_t> _expiredEvents{};
+  TimingWheel::TimerId       _foodTimer{TimingWheel::kInvalidTimer};
+  TimingWheel::TimerId       _spawnTimer{TimingWheel::kInvalidTimer};
+  TimingWheel::TimerId       _boostTimer{TimingWheel::kInvalidTimer};
+  std::array<TimingWheel::TimerId, kMaxPowerUps> _powerUpTimers{};
+  PowerUps                   _powerUps{};
+  std::uint32_t              _foodExpiresAt{0};
+  std::uint32_t              _nextSpawnAt{0};
+  std::uint32_t              _boostEndsAt{0};   // 0 while no speed boost is active
 
   // To store players and their scores
   std::unordered_map <std::string, std::string> _scoreboard{};
@@ -0,0 +1,69 @@
+#include "governor.h"
+
+namespace {
+// Quality levels, from best looking to cheapest
+struct GovernorLevel {
+  std::size_t          renderInterval;  // Render once every N simulation ticks
+  RenderBackend::RenderPath renderPath;
+};
+
+constexpr GovernorLevel kLevels[] = {
+  {1, RenderBackend::RenderPath::kFullRedraw},
+  {1, RenderBackend::RenderPath::kIncremental},
+  {2, RenderBackend::RenderPath::kIncremental},
+  {4, RenderBackend::RenderPath::kIncremental},
+};
+constexpr int kLevelCount = sizeof(kLevels) / sizeof(kLevels[0]);
+}  // namespace
+
+PerformanceGovernor::PerformanceGovernor(double tickBudgetMs)
+    : _tickBudget(tickBudgetMs) {}
+
+void PerformanceGovernor::recordTick(double simulationMs) {
+  _simulationCost += kSmoothing * (simulationMs - _simulationCost);
+}
+
+void PerformanceGovernor::recordRender(double renderMs) {
+  _renderCost += kSmoothing * (renderMs - _renderCost);
+}
+
+/*
+ * Called once per loop iteration
+ * A level change needs a sustained trend, so that a single slow frame
+ * (e.g. a window manager hiccup) does not make the quality flicker.
+ */
+void PerformanceGovernor::evaluate() {
+  if (projectedLoad_(_level) > kDegradeLoad * _tickBudget) {
+    _framesUnderBudget = 0;
+    if (++_framesOverBudget >= kDegradeFrames && _level + 1 < kLevelCount) {
+      ++_level;
+      _framesOverBudget = 0;
+    }
+  } else if (_level > 0 && projectedLoad_(_level - 1) < kUpgradeLoad * _tickBudget) {
+    _framesOverBudget = 0;
+    if (++_framesUnderBudget >= kUpgradeFrames) {
+      --_level;
+      _framesUnderBudget = 0;
+    }
+  } else {
+    _framesOverBudget  = 0;
+    _framesUnderBudget = 0;
+  }
+}
+
+std::size_t PerformanceGovernor::renderInterval() const {
+  return kLevels[_level].renderInterval;
+}
+
+RenderBackend::RenderPath PerformanceGovernor::renderPath() const {
+  return kLevels[_level].renderPath;
+}
+
+int PerformanceGovernor::level() const {
+  return _level;
+}
+
+// Average cost per simulation tick if the given level was active
+double PerformanceGovernor::projectedLoad_(int level) const {
+  return _simulationCost + _renderCost / static_cast<double>(kLevels[level].renderInterval);
+}
@@ -0,0 +1,47 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <cstddef>
+#include "render_backend.h"
+
+/*
+ * Adaptive performance governor
+ * Watches the measured cost of simulation and rendering and trades render
+ * quality for a stable simulation rate: first by switching to incremental
+ * rendering, then by rendering only every Nth simulation tick. Quality is
+ * restored once there is enough headroom again.
+ */
+class PerformanceGovernor {
+ public:
+  // Constructor
+  explicit PerformanceGovernor(double tickBudgetMs);
+
+  // Public methods
+  void recordTick(double simulationMs);
+  void recordRender(double renderMs);
+  void evaluate();
+  std::size_t renderInterval() const;
+  RenderBackend::RenderPath renderPath() const;
+  int level() const;
+
+  // Public data
+  const double kDegradeLoad{0.75};     // Fraction of the tick budget that triggers a downgrade
+  const double kUpgradeLoad{0.45};     // Projected fraction of the budget that allows an upgrade
+  const int    kDegradeFrames{30};     // Consecutive frames over budget before downgrading
+  const int    kUpgradeFrames{120};    // Consecutive frames with headroom before upgrading
+  const double kSmoothing{0.1};        // Weight of a new sample in the moving averages
+
+ private:
+  // Private methods
+  double projectedLoad_(int level) const;
+
+  // Private data
+  double _tickBudget;
+  double _simulationCost{0.0};  // Moving average per simulation tick, in ms
+  double _renderCost{0.0};      // Moving average per rendered frame, in ms
+  int    _level{0};
+  int    _framesOverBudget{0};
+  int    _framesUnderBudget{0};
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "image_writer.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace ImageWriter {
+
+namespace {
+
+// One row of 8 bit RGB samples
+void packRow(const std::uint32_t *pixels, std::size_t width, unsigned char *out) {
+  for (std::size_t x = 0; x < width; ++x) {
+    std::uint32_t pixel = pixels[x];
+    out[3 * x]     = static_cast<unsigned char>(pixel);
+    out[3 * x + 1] = static_cast<unsigned char>(pixel >> 8);
+    out[3 * x + 2] = static_cast<unsigned char>(pixel >> 16);
+  }
+}
+
+std::uint32_t crc32(std::uint32_t crc, const unsigned char *data, std::size_t size) {
+  static const std::array<std::uint32_t, 256> kTable = [] {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t n = 0; n < 256; ++n) {
+      std::uint32_t c = n;
+      for (int k = 0; k < 8; ++k) { c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1; }
+      table[n] = c;
+    }
+    return table;
+  }();
+  crc = ~crc;
+  for (std::size_t i = 0; i < size; ++i) { crc = kTable[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8); }
+  return ~crc;
+}
+
+void appendBigEndian(std::vector<unsigned char> &out, std::uint32_t value) {
+  out.push_back(static_cast<unsigned char>(value >> 24));
+  out.push_back(static_cast<unsigned char>(value >> 16));
+  out.push_back(static_cast<unsigned char>(value >> 8));
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+// Length, type, data and the CRC over type and data
+void appendChunk(std::vector<unsigned char> &out, const char *type,
+                 std::vector<unsigned char> const &data) {
+  appendBigEndian(out, static_cast<std::uint32_t>(data.size()));
+  std::size_t typeStart = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  appendBigEndian(out, crc32(0, out.data() + typeStart, out.size() - typeStart));
+}
+
+bool writeFile(std::string const &path, const unsigned char *data, std::size_t size) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Failed to write " << path << "\n";
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+  return static_cast<bool>(file);
+}
+
+}  // namespace
+
+// Binary PPM (P6): a short text header followed by raw RGB samples
+bool writePpm(std::string const &path, const std::uint32_t *pixels, std::size_t width,
+              std::size_t height) {
+  std::string header{"P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n"};
+  std::vector<unsigned char> image(header.begin(), header.end());
+  image.resize(header.size() + width * height * 3);
+  for (std::size_t y = 0; y < height; ++y) {
+    packRow(pixels + y * width, width, image.data() + header.size() + y * width * 3);
+  }
+  return writeFile(path, image.data(), image.size());
+}
+
+/*
+ * 8 bit RGB PNG
+ * The zlib stream is a sequence of stored deflate blocks of up to 65535
+ * bytes, each row prefixed by filter type 0 (none).
+ */
+bool writePng(std::string const &path, const std::uint32_t *pixels, std::size_t width,
+              std::size_t height) {
+  constexpr std::size_t kMaxStoredBlock{65535};
+
+  std::size_t rowBytes = 1 + width * 3;
+  std::vector<unsigned char> raw(rowBytes * height);
+  for (std::size_t y = 0; y < height; ++y) {
+    raw[y * rowBytes] = 0;
+    packRow(pixels + y * width, width, raw.data() + y * rowBytes + 1);
+  }
+
+  std::vector<unsigned char> zlib{0x78, 0x01};
+  zlib.reserve(raw.size() + raw.size() / kMaxStoredBlock * 5 + 16);
+  std::size_t offset = 0;
+  do {
+    std::size_t size = std::min(kMaxStoredBlock, raw.size() - offset);
+    bool last = offset + size == raw.size();
+    zlib.push_back(last ? 1 : 0);
+    zlib.push_back(static_cast<unsigned char>(size));
+    zlib.push_back(static_cast<unsigned char>(size >> 8));
+    zlib.push_back(static_cast<unsigned char>(~size));
+    zlib.push_back(static_cast<unsigned char>(~size >> 8));
+    zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+    offset += size;
+  } while (offset < raw.size());
+
+  // Adler-32 of the raw data, reduced only every kAdlerRun bytes which cannot overflow
+  constexpr std::size_t kAdlerRun{5552};
+  std::uint32_t adlerLow = 1;
+  std::uint32_t adlerHigh = 0;
+  for (std::size_t start = 0; start < raw.size(); start += kAdlerRun) {
+    std::size_t end = std::min(start + kAdlerRun, raw.size());
+    for (std::size_t i = start; i < end; ++i) {
+      adlerLow += raw[i];
+      adlerHigh += adlerLow;
+    }
+    adlerLow %= 65521u;
+    adlerHigh %= 65521u;
+  }
+  appendBigEndian(zlib, (adlerHigh << 16) | adlerLow);
+
+  std::vector<unsigned char> header{};
+  appendBigEndian(header, static_cast<std::uint32_t>(width));
+  appendBigEndian(header, static_cast<std::uint32_t>(height));
+  header.insert(header.end(), {8, 2, 0, 0, 0});  // 8 bit RGB, deflate, no filtering, no interlace
+
+  std::vector<unsigned char> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  png.reserve(zlib.size() + 64);
+  appendChunk(png, "IHDR", header);
+  appendChunk(png, "IDAT", zlib);
+  appendChunk(png, "IEND", {});
+  return writeFile(path, png.data(), png.size());
+}
+
+}  // namespace ImageWriter
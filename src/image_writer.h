@@ -0,0 +1,23 @@
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ * Writes RGBA pixel buffers to image files without external libraries
+ * Pixels are packed as 0xAABBGGRR, i.e. red in the lowest byte; alpha is
+ * dropped. PNG output uses stored (uncompressed) deflate blocks, so it
+ * needs no zlib and costs little more than copying the pixels.
+ */
+namespace ImageWriter {
+
+bool writePpm(std::string const &path, const std::uint32_t *pixels, std::size_t width,
+              std::size_t height);
+bool writePng(std::string const &path, const std::uint32_t *pixels, std::size_t width,
+              std::size_t height);
+
+}  // namespace ImageWriter
+
+#endif
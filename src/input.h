@@ -0,0 +1,28 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <cassert>
+#include <cstdint>
+#include "snake.h"
+
+/*
+ * Input of one player for one simulation tick
+ * Either no input or a requested direction, encoded in 4 bits so that
+ * two inputs fit into one byte of a network packet.
+ */
+using PlayerInput = std::uint8_t;
+
+constexpr PlayerInput kNoInput{0};
+constexpr PlayerInput kMaxInput{4};  // Encoded Direction::kRight, anything above is invalid
+
+inline PlayerInput encodeDirection(Snake::Direction direction) {
+  return static_cast<PlayerInput>(static_cast<int>(direction) + 1);
+}
+
+// Only valid for inputs other than kNoInput
+inline Snake::Direction decodeDirection(PlayerInput input) {
+  assert(input != kNoInput && input <= kMaxInput);
+  return static_cast<Snake::Direction>(input - 1);
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "level.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// Move Constructor
+Level::Level(Level &&source) : _file(std::move(source._file)) {
+  _header     = source._header;
+  _walls      = source._walls;
+  _portalMask = source._portalMask;
+  _freeCells  = source._freeCells;
+  _clearance  = source._clearance;
+  _spawns     = source._spawns;
+  _portals    = source._portals;
+
+  // Invalidating source after move operation
+  source.close_();
+}
+
+// Move Assignment Operator
+Level &Level::operator=(Level &&source) {
+  if (this == &source) { return *this; }  // To handle self assignment scenario
+
+  close_();
+  _file       = std::move(source._file);
+  _header     = source._header;
+  _walls      = source._walls;
+  _portalMask = source._portalMask;
+  _freeCells  = source._freeCells;
+  _clearance  = source._clearance;
+  _spawns     = source._spawns;
+  _portals    = source._portals;
+
+  // Invalidating source after move operation
+  source.close_();
+
+  return *this;
+}
+
+/*
+ * Memory-map a level compiled by LevelPacker
+ * Only the header is read here, the sections are paged in on first use.
+ */
+bool Level::openFile(std::string const &path) {
+  close_();
+
+  if (!_file.open(path)) {
+    std::cerr << "Level " << path << " could not be opened.\n";
+    return false;
+  }
+  if (!validate_()) {
+    std::cerr << "Level " << path << " is corrupted.\n";
+    close_();
+    return false;
+  }
+  return true;
+}
+
+bool Level::isOpen() const {
+  return nullptr != _header;
+}
+
+int Level::width() const {
+  return static_cast<int>(_header->width);
+}
+
+int Level::height() const {
+  return static_cast<int>(_header->height);
+}
+
+// Whether the cell is a wall, a single bit test
+bool Level::wall(int x, int y) const {
+  return testBit_(_walls, _header->wordsPerRow, x, y);
+}
+
+// Whether the cell is either end of a portal
+bool Level::portal(int x, int y) const {
+  return testBit_(_portalMask, _header->wordsPerRow, x, y);
+}
+
+// Cell a snake entering the portal at (x, y) comes out of, (x, y) if there is no portal
+SDL_Point Level::portalExit(int x, int y) const {
+  std::uint32_t cell = static_cast<std::uint32_t>(y) * _header->width + static_cast<std::uint32_t>(x);
+  const LevelFormat::LevelPortal *end = _portals + _header->portalCount;
+  const LevelFormat::LevelPortal *it = std::lower_bound(
+      _portals, end, cell,
+      [](LevelFormat::LevelPortal const &portal, std::uint32_t key) { return portal.entrance < key; });
+  if (it != end && it->entrance == cell) { return point_(it->exit); }
+  return SDL_Point{x, y};
+}
+
+std::size_t Level::freeCellCount() const {
+  return _header->freeCellCount;
+}
+
+SDL_Point Level::freeCell(std::size_t index) const {
+  return point_(_freeCells[index]);
+}
+
+// Number of steps from the cell to the nearest wall, for AI and spawn safety
+std::uint16_t Level::clearance(int x, int y) const {
+  return _clearance[static_cast<std::size_t>(y) * _header->width + static_cast<std::size_t>(x)];
+}
+
+std::size_t Level::spawnCount() const {
+  return _header->spawnCount;
+}
+
+SDL_Point Level::spawn(std::size_t index) const {
+  return point_(_spawns[index]);
+}
+
+/*
+ * Check the header and that every section lies inside the file, so that
+ * queries never read outside the mapping. The small spawn and portal
+ * sections are checked entry by entry; the per-cell sections are trusted,
+ * checking them would mean reading the whole file.
+ */
+bool Level::validate_() {
+  using namespace LevelFormat;
+
+  const unsigned char *data = _file.data();
+  std::size_t size = _file.size();
+  if (nullptr == data || size < sizeof(LevelHeader)) { return false; }
+
+  auto header = reinterpret_cast<const LevelHeader *>(data);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+    return false;
+  }
+
+  std::uint64_t cells = static_cast<std::uint64_t>(header->width) * header->height;
+  if (cells == 0 || cells > 0xFFFFFFFFull || header->wordsPerRow != (header->width + 63) / 64 ||
+      header->freeCellCount == 0 || header->freeCellCount > cells || header->spawnCount == 0) {
+    return false;
+  }
+
+  auto fits = [size](std::uint64_t offset, std::uint64_t bytes) {
+    return offset % kSectionAlignment == 0 && offset <= size && bytes <= size - offset;
+  };
+  std::uint64_t bitmapBytes = static_cast<std::uint64_t>(header->wordsPerRow) * header->height * 8;
+  if (!fits(header->wallsOffset, bitmapBytes) || !fits(header->portalMaskOffset, bitmapBytes) ||
+      !fits(header->freeCellsOffset, header->freeCellCount * 4ull) ||
+      !fits(header->clearanceOffset, cells * 2) ||
+      !fits(header->spawnsOffset, header->spawnCount * 4ull) ||
+      !fits(header->portalsOffset, header->portalCount * sizeof(LevelPortal))) {
+    return false;
+  }
+
+  _header     = header;
+  _walls      = reinterpret_cast<const std::uint64_t *>(data + header->wallsOffset);
+  _portalMask = reinterpret_cast<const std::uint64_t *>(data + header->portalMaskOffset);
+  _freeCells  = reinterpret_cast<const std::uint32_t *>(data + header->freeCellsOffset);
+  _clearance  = reinterpret_cast<const std::uint16_t *>(data + header->clearanceOffset);
+  _spawns     = reinterpret_cast<const std::uint32_t *>(data + header->spawnsOffset);
+  _portals    = reinterpret_cast<const LevelPortal *>(data + header->portalsOffset);
+
+  // Spawns must be free cells, portals must connect cells on the board
+  for (std::uint32_t i = 0; i < header->spawnCount; ++i) {
+    std::uint32_t cell = _spawns[i];
+    int x = static_cast<int>(cell % header->width);
+    int y = static_cast<int>(cell / header->width);
+    if (cell >= cells || wall(x, y) || portal(x, y)) { return false; }
+  }
+  for (std::uint32_t i = 0; i < header->portalCount; ++i) {
+    if (_portals[i].entrance >= cells || _portals[i].exit >= cells) { return false; }
+  }
+  return true;
+}
+
+void Level::close_() {
+  _file.close();
+  _header     = nullptr;
+  _walls      = nullptr;
+  _portalMask = nullptr;
+  _freeCells  = nullptr;
+  _clearance  = nullptr;
+  _spawns     = nullptr;
+  _portals    = nullptr;
+}
+
+// Free cells are not checked up front, out of range indices (a damaged file) map to the origin
+SDL_Point Level::point_(std::uint32_t cell) const {
+  if (cell >= _header->width * _header->height) { return SDL_Point{0, 0}; }
+  return SDL_Point{static_cast<int>(cell % _header->width), static_cast<int>(cell / _header->width)};
+}
+
+bool Level::testBit_(const std::uint64_t *bitmap, std::size_t wordsPerRow, int x, int y) {
+  std::uint64_t word = bitmap[static_cast<std::size_t>(y) * wordsPerRow + static_cast<std::size_t>(x) / 64];
+  return (word >> (x % 64)) & 1u;
+}
@@ -0,0 +1,67 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SDL.h"
+#include "level_format.h"
+#include "mapped_file.h"
+
+/*
+ * Read-only view over a compiled level (see level_format.h)
+ * The level file is memory-mapped and every query reads the precomputed
+ * sections in place: wall and portal tests are a single bitmap lookup,
+ * free cells and clearance are plain array reads.
+ */
+class Level {
+ public:
+  // Constructor
+  Level() = default;
+
+  /*
+   * Rule of 5 implementation
+   * Adopting a "No Copy, Only Move" memory management policy
+   */
+  Level(const Level &) = delete;             // Delete copy constructor
+  Level &operator=(const Level &) = delete;  // Delete copy assignment operator
+
+  // Move Constructor
+  Level(Level &&source);
+
+  // Move Assignment Operator
+  Level &operator=(Level &&source);
+
+  // Public methods
+  bool openFile(std::string const &path);
+  bool isOpen() const;
+  int width() const;
+  int height() const;
+  bool wall(int x, int y) const;
+  bool portal(int x, int y) const;
+  SDL_Point portalExit(int x, int y) const;
+  std::size_t freeCellCount() const;
+  SDL_Point freeCell(std::size_t index) const;
+  std::uint16_t clearance(int x, int y) const;
+  std::size_t spawnCount() const;
+  SDL_Point spawn(std::size_t index) const;
+
+ private:
+  // Private methods
+  bool validate_();
+  void close_();
+  SDL_Point point_(std::uint32_t cell) const;
+  static bool testBit_(const std::uint64_t *bitmap, std::size_t wordsPerRow, int x, int y);
+
+  // Private data
+  MappedFile                       _file{};
+  const LevelFormat::LevelHeader  *_header{nullptr};
+  const std::uint64_t             *_walls{nullptr};
+  const std::uint64_t             *_portalMask{nullptr};
+  const std::uint32_t             *_freeCells{nullptr};
+  const std::uint16_t             *_clearance{nullptr};
+  const std::uint32_t             *_spawns{nullptr};
+  const LevelFormat::LevelPortal  *_portals{nullptr};
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include <cstdint>
+
+/*
+ * On-disk layout of a compiled level (.lvl)
+ *
+ *   LevelHeader
+ *   wall bitmap        <- std::uint64_t[height * wordsPerRow], bit x % 64 of word x / 64
+ *   portal bitmap      <- same layout, set on both ends of every portal
+ *   free cells         <- std::uint32_t[freeCellCount], cell indices (y * width + x)
+ *   clearance field    <- std::uint16_t[width * height], steps to the nearest wall
+ *   spawn points       <- std::uint32_t[spawnCount], cell indices
+ *   portals            <- LevelPortal[portalCount], sorted by entrance
+ *
+ * Every section starts at a multiple of kSectionAlignment so the runtime
+ * can use it in place. Everything the game needs per cell is precomputed
+ * by the LevelPacker tool, so loading is a mapping plus a header check.
+ * All fields are stored in the host byte order. Kept free of any SDL
+ * dependency so the packer can include it directly.
+ */
+namespace LevelFormat {
+
+constexpr char          kMagic[4]{'S', 'N', 'K', 'L'};
+constexpr std::uint32_t kVersion{1};
+constexpr std::uint32_t kSectionAlignment{64};
+constexpr std::uint16_t kNoWall{0xFFFF};  // Clearance of cells on a level without walls
+
+struct LevelHeader {
+  char          magic[4];
+  std::uint32_t version;
+  std::uint32_t width;
+  std::uint32_t height;
+  std::uint32_t wordsPerRow;     // Bitmap words per row
+  std::uint32_t freeCellCount;
+  std::uint32_t spawnCount;
+  std::uint32_t portalCount;     // Entries, i.e. two per portal pair
+  std::uint64_t wallsOffset;     // Section offsets from the start of the file
+  std::uint64_t portalMaskOffset;
+  std::uint64_t freeCellsOffset;
+  std::uint64_t clearanceOffset;
+  std::uint64_t spawnsOffset;
+  std::uint64_t portalsOffset;
+};
+
+// One direction of a portal, the pair is stored as two entries
+struct LevelPortal {
+  std::uint32_t entrance;  // Cell indices
+  std::uint32_t exit;
+};
+
+static_assert(sizeof(LevelHeader) == 80, "Unexpected level header layout");
+static_assert(sizeof(LevelPortal) == 8, "Unexpected level portal layout");
+
+}  // namespace LevelFormat
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * LevelPacker - build time tool that compiles a text level into the binary
+ * level format (see level_format.h)
+ *
+ * Usage: LevelPacker -o <level.lvl> <level.txt>
+ *        LevelPacker -o <level.lvl> --generate <width> <height> [seed]
+ *
+ * Text levels have one line per row: '#' is a wall, '.' or ' ' is floor,
+ * 'S' is a spawn point and each lowercase letter marks both ends of a
+ * portal. --generate builds a walled random arena instead, e.g. to try
+ * out very large levels.
+ */
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "level_format.h"
+#include "random.h"
+
+namespace {
+
+struct LevelSource {
+  std::uint32_t              width{0};
+  std::uint32_t              height{0};
+  std::vector<unsigned char> walls{};   // One flag per cell
+  std::vector<std::uint32_t> spawns{};
+  std::vector<LevelFormat::LevelPortal> portals{};
+};
+
+bool readText(std::string const &path, LevelSource &level) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open " << path << "\n";
+    return false;
+  }
+  std::vector<std::string> rows{};
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+    rows.push_back(line);
+  }
+  while (!rows.empty() && rows.back().empty()) { rows.pop_back(); }
+
+  level.height = static_cast<std::uint32_t>(rows.size());
+  for (std::string const &row : rows) {
+    level.width = std::max(level.width, static_cast<std::uint32_t>(row.size()));
+  }
+  if (level.width == 0 || level.height == 0) {
+    std::cerr << path << " is empty\n";
+    return false;
+  }
+
+  level.walls.assign(static_cast<std::size_t>(level.width) * level.height, 0);
+  std::vector<std::vector<std::uint32_t>> portalEnds(26);
+  for (std::uint32_t y = 0; y < level.height; ++y) {
+    for (std::uint32_t x = 0; x < rows[y].size(); ++x) {
+      char tile = rows[y][x];
+      std::uint32_t cell = y * level.width + x;
+      if (tile == '#') {
+        level.walls[cell] = 1;
+      } else if (tile == 'S') {
+        level.spawns.push_back(cell);
+      } else if (tile >= 'a' && tile <= 'z') {
+        portalEnds[tile - 'a'].push_back(cell);
+      } else if (tile != '.' && tile != ' ') {
+        std::cerr << path << ":" << y + 1 << ": unknown tile '" << tile << "'\n";
+        return false;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < portalEnds.size(); ++i) {
+    if (portalEnds[i].empty()) { continue; }
+    if (portalEnds[i].size() != 2) {
+      std::cerr << path << ": portal '" << static_cast<char>('a' + i)
+                << "' must appear exactly twice\n";
+      return false;
+    }
+    level.portals.push_back(LevelFormat::LevelPortal{portalEnds[i][0], portalEnds[i][1]});
+    level.portals.push_back(LevelFormat::LevelPortal{portalEnds[i][1], portalEnds[i][0]});
+  }
+  return true;
+}
+
+// Walled arena with scattered wall blocks and a few portals
+void generate(std::uint32_t width, std::uint32_t height, std::uint64_t seed, LevelSource &level) {
+  Random random(seed);
+  level.width  = width;
+  level.height = height;
+  level.walls.assign(static_cast<std::size_t>(width) * height, 0);
+
+  for (std::uint32_t x = 0; x < width; ++x) {
+    level.walls[x] = 1;
+    level.walls[static_cast<std::size_t>(height - 1) * width + x] = 1;
+  }
+  for (std::uint32_t y = 0; y < height; ++y) {
+    level.walls[static_cast<std::size_t>(y) * width] = 1;
+    level.walls[static_cast<std::size_t>(y) * width + width - 1] = 1;
+  }
+
+  // Blocks of up to 8x8 cells covering roughly 5% of the arena
+  std::size_t blocks = static_cast<std::size_t>(width) * height / 400;
+  for (std::size_t i = 0; i < blocks; ++i) {
+    int w = random.uniform(1, 8);
+    int h = random.uniform(1, 8);
+    int left = random.uniform(1, static_cast<int>(width) - 2);
+    int top  = random.uniform(1, static_cast<int>(height) - 2);
+    for (int y = top; y < std::min(top + h, static_cast<int>(height) - 1); ++y) {
+      for (int x = left; x < std::min(left + w, static_cast<int>(width) - 1); ++x) {
+        level.walls[static_cast<std::size_t>(y) * width + x] = 1;
+      }
+    }
+  }
+
+  // Up to four portal pairs, fewer on tiny arenas so that a free cell is left to spawn on
+  std::size_t freeCells = static_cast<std::size_t>(std::count(level.walls.begin(), level.walls.end(), 0));
+  std::size_t portalEnds = freeCells > 0 ? std::min<std::size_t>(8, (freeCells - 1) / 2 * 2) : 0;
+  std::vector<std::uint32_t> ends{};
+  while (ends.size() < portalEnds) {
+    std::uint32_t cell = random.next() % (width * height);
+    if (!level.walls[cell] && std::find(ends.begin(), ends.end(), cell) == ends.end()) {
+      ends.push_back(cell);
+    }
+  }
+  for (std::size_t i = 0; i < ends.size(); i += 2) {
+    level.portals.push_back(LevelFormat::LevelPortal{ends[i], ends[i + 1]});
+    level.portals.push_back(LevelFormat::LevelPortal{ends[i + 1], ends[i]});
+  }
+}
+
+/*
+ * Steps from every cell to the nearest wall, a breadth first search from
+ * all walls at once. Moves wrap around the edges like the snake does.
+ */
+std::vector<std::uint16_t> clearanceField(LevelSource const &level) {
+  std::vector<std::uint16_t> field(level.walls.size(), LevelFormat::kNoWall);
+  std::deque<std::uint32_t> frontier{};
+  for (std::uint32_t cell = 0; cell < level.walls.size(); ++cell) {
+    if (level.walls[cell]) {
+      field[cell] = 0;
+      frontier.push_back(cell);
+    }
+  }
+
+  while (!frontier.empty()) {
+    std::uint32_t cell = frontier.front();
+    frontier.pop_front();
+    std::uint32_t x = cell % level.width;
+    std::uint32_t y = cell / level.width;
+    std::uint32_t neighbours[4]{
+        y * level.width + (x + 1) % level.width,
+        y * level.width + (x + level.width - 1) % level.width,
+        ((y + 1) % level.height) * level.width + x,
+        ((y + level.height - 1) % level.height) * level.width + x};
+    std::uint16_t distance = static_cast<std::uint16_t>(std::min<int>(field[cell] + 1, LevelFormat::kNoWall - 1));
+    for (std::uint32_t neighbour : neighbours) {
+      if (field[neighbour] == LevelFormat::kNoWall) {
+        field[neighbour] = distance;
+        frontier.push_back(neighbour);
+      }
+    }
+  }
+  return field;
+}
+
+std::size_t align(std::size_t offset) {
+  return (offset + LevelFormat::kSectionAlignment - 1) / LevelFormat::kSectionAlignment *
+         LevelFormat::kSectionAlignment;
+}
+
+template <typename T>
+void writeSection(std::vector<unsigned char> &file, std::uint64_t offset, std::vector<T> const &section) {
+  auto bytes = reinterpret_cast<const unsigned char *>(section.data());
+  std::copy(bytes, bytes + section.size() * sizeof(T), file.begin() + offset);
+}
+
+bool buildLevel(LevelSource &level, std::vector<unsigned char> &file) {
+  using namespace LevelFormat;
+
+  std::size_t cells = level.walls.size();
+  std::uint32_t wordsPerRow = (level.width + 63) / 64;
+  std::vector<std::uint64_t> walls(static_cast<std::size_t>(wordsPerRow) * level.height, 0);
+  std::vector<std::uint64_t> portalMask(walls.size(), 0);
+  auto setBit = [&](std::vector<std::uint64_t> &bitmap, std::uint32_t cell) {
+    std::uint32_t x = cell % level.width;
+    std::uint32_t y = cell / level.width;
+    bitmap[static_cast<std::size_t>(y) * wordsPerRow + x / 64] |= std::uint64_t{1} << (x % 64);
+  };
+
+  for (std::uint32_t cell = 0; cell < cells; ++cell) {
+    if (level.walls[cell]) { setBit(walls, cell); }
+  }
+  for (LevelPortal const &portal : level.portals) { setBit(portalMask, portal.entrance); }
+  std::sort(level.portals.begin(), level.portals.end(),
+            [](LevelPortal const &a, LevelPortal const &b) { return a.entrance < b.entrance; });
+
+  // Food and power-ups may go anywhere that is neither a wall nor a portal
+  std::vector<std::uint32_t> freeCells{};
+  for (std::uint32_t cell = 0; cell < cells; ++cell) {
+    std::uint32_t x = cell % level.width;
+    std::uint32_t y = cell / level.width;
+    bool portal = (portalMask[static_cast<std::size_t>(y) * wordsPerRow + x / 64] >> (x % 64)) & 1u;
+    if (!level.walls[cell] && !portal) { freeCells.push_back(cell); }
+  }
+  if (freeCells.empty()) {
+    std::cerr << "Level has no free cells\n";
+    return false;
+  }
+
+  std::vector<std::uint16_t> clearance = clearanceField(level);
+
+  // Without explicit spawn points use the free cell farthest from any wall
+  if (level.spawns.empty()) {
+    level.spawns.push_back(*std::max_element(
+        freeCells.begin(), freeCells.end(),
+        [&](std::uint32_t a, std::uint32_t b) { return clearance[a] < clearance[b]; }));
+  }
+
+  LevelHeader header{};
+  std::copy(std::begin(kMagic), std::end(kMagic), header.magic);
+  header.version          = kVersion;
+  header.width            = level.width;
+  header.height           = level.height;
+  header.wordsPerRow      = wordsPerRow;
+  header.freeCellCount    = static_cast<std::uint32_t>(freeCells.size());
+  header.spawnCount       = static_cast<std::uint32_t>(level.spawns.size());
+  header.portalCount      = static_cast<std::uint32_t>(level.portals.size());
+  header.wallsOffset      = align(sizeof(LevelHeader));
+  header.portalMaskOffset = align(header.wallsOffset + walls.size() * sizeof(std::uint64_t));
+  header.freeCellsOffset  = align(header.portalMaskOffset + portalMask.size() * sizeof(std::uint64_t));
+  header.clearanceOffset  = align(header.freeCellsOffset + freeCells.size() * sizeof(std::uint32_t));
+  header.spawnsOffset     = align(header.clearanceOffset + clearance.size() * sizeof(std::uint16_t));
+  header.portalsOffset    = align(header.spawnsOffset + level.spawns.size() * sizeof(std::uint32_t));
+
+  file.assign(header.portalsOffset + level.portals.size() * sizeof(LevelPortal), 0);
+  auto headerBytes = reinterpret_cast<const unsigned char *>(&header);
+  std::copy(headerBytes, headerBytes + sizeof(header), file.begin());
+  writeSection(file, header.wallsOffset, walls);
+  writeSection(file, header.portalMaskOffset, portalMask);
+  writeSection(file, header.freeCellsOffset, freeCells);
+  writeSection(file, header.clearanceOffset, clearance);
+  writeSection(file, header.spawnsOffset, level.spawns);
+  writeSection(file, header.portalsOffset, level.portals);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::string levelPath{};
+  std::string sourcePath{};
+  LevelSource level;
+  bool generated = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "-o" && i + 1 < argc) {
+      levelPath = argv[++i];
+    } else if (arg == "--generate" && i + 2 < argc) {
+      std::uint32_t width  = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+      std::uint32_t height = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+      std::uint64_t seed   = (i + 1 < argc && argv[i + 1][0] != '-') ? std::stoull(argv[++i]) : 1;
+      if (width < 3 || height < 3 || static_cast<std::uint64_t>(width) * height > 0xFFFFFFFFull) {
+        std::cerr << "Unsupported level size\n";
+        return 1;
+      }
+      generate(width, height, seed, level);
+      generated = true;
+    } else {
+      sourcePath = arg;
+    }
+  }
+
+  if (levelPath.empty() || (sourcePath.empty() && !generated)) {
+    std::cerr << "Usage: LevelPacker -o <level.lvl> <level.txt>\n"
+              << "       LevelPacker -o <level.lvl> --generate <width> <height> [seed]\n";
+    return 1;
+  }
+  if (!generated && !readText(sourcePath, level)) { return 1; }
+
+  std::vector<unsigned char> file;
+  if (!buildLevel(level, file)) { return 1; }
+
+  std::ofstream levelFile(levelPath, std::ios::binary);
+  if (!levelFile.is_open()) {
+    std::cerr << "Failed to write " << levelPath << "\n";
+    return 1;
+  }
+  levelFile.write(reinterpret_cast<const char *>(file.data()), file.size());
+  return levelFile ? 0 : 1;
+}
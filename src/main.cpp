@@ -1,28 +1,233 @@
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <thread>
 #include <memory>
+#include <string>
+#include "asset_bundle.h"
+#include "audio.h"
 #include "controller.h"
 #include "game.h"
+#include "level.h"
 #include "renderer.h"
+#include "sdl_context.h"
+#include "session_host.h"
+#include "software_renderer.h"
+#ifdef SNAKE_NETPLAY
+#include "netclient.h"
+#include "netgame.h"
+#endif
+
+namespace {
+
+// Parse a whole decimal number no larger than max, false for anything else
+bool parseNumber(std::string const &text, unsigned long max, unsigned long &value) {
+  if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) { return false; }
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtoul(text.c_str(), &end, 10);
+  return errno == 0 && *end == '\0' && value <= max;
+}
+
+void printUsage() {
+  std::cerr << "Usage: SnakeGame [--no-audio] [--practice] [--level file.lvl]\n"
+            << "                 [--sessions N] [--windows] [--headless prefix [--frames N]]\n"
+#ifdef SNAKE_NETPLAY
+            << "                 [--connect host:port] [--match id]\n"
+#endif
+            ;
+}
+
+}  // namespace
+
+/*
+ * Command line options
+ * --no-audio : Run without opening an audio device, e.g. on headless machines
+ * --practice : Practice mode, press 'r' to rewind 5 seconds, scores are not recorded
+ * --level file.lvl : Play on a level compiled by LevelPacker instead of the open board
+ * --sessions N : Host N (1 to 16) independent boards in one split screen window
+ * --windows : With --sessions, give every board its own window, spread over the displays
+ * --headless prefix : Play a scripted game offscreen as fast as possible, without a window or
+ *                     audio, writing every 60th frame to prefixNNNNNN.png
+ * --frames N : With --headless, stop after N frames (default 3600) if the snake is still alive
+ * --connect host:port : Play online against another player through a SnakeRelay server
+ * --match id : Match to join on the relay, both players must use the same id (default 0)
+ */
+int main(int argc, char *argv[]) {
+  constexpr unsigned long kMaxSessions{16};
+
+  bool audioEnabled = true;
+  bool practiceMode = false;
+  std::string levelPath{};
+  std::size_t sessions = 1;
+  SessionHost::Layout layout = SessionHost::Layout::kSplitScreen;
+  bool headless = false;
+  std::string recordPrefix{};
+  std::size_t headlessFrames = 3600;
+#ifdef SNAKE_NETPLAY
+  std::string relayAddress{};
+  std::uint32_t matchId = 0;
+#endif
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "--no-audio") { audioEnabled = false; }
+    if (arg == "--practice") { practiceMode = true; }
+    if (arg == "--level" && i + 1 < argc) { levelPath = argv[++i]; }
+    if (arg == "--sessions" && i + 1 < argc) {
+      unsigned long value;
+      if (!parseNumber(argv[++i], kMaxSessions, value) || value == 0) {
+        std::cerr << "--sessions expects a number from 1 to " << kMaxSessions << "\n";
+        printUsage();
+        return 1;
+      }
+      sessions = value;
+    }
+    if (arg == "--windows") { layout = SessionHost::Layout::kWindows; }
+    if (arg == "--headless" && i + 1 < argc) {
+      headless = true;
+      recordPrefix = argv[++i];
+    }
+    if (arg == "--frames" && i + 1 < argc) {
+      unsigned long value;
+      if (!parseNumber(argv[++i], 0xFFFFFFFFul, value)) {
+        std::cerr << "--frames expects a non-negative number\n";
+        printUsage();
+        return 1;
+      }
+      headlessFrames = value;
+    }
+#ifdef SNAKE_NETPLAY
+    if (arg == "--connect" && i + 1 < argc) { relayAddress = argv[++i]; }
+    if (arg == "--match" && i + 1 < argc) {
+      unsigned long value;
+      if (!parseNumber(argv[++i], 0xFFFFFFFFul, value)) {
+        std::cerr << "--match expects a non-negative number\n";
+        printUsage();
+        return 1;
+      }
+      matchId = static_cast<std::uint32_t>(value);
+    }
+#endif
+  }
 
-int main() {
   // Define Game constants
   constexpr std::size_t kScreenWidth{640};
   constexpr std::size_t kScreenHeight{640};
   constexpr std::size_t kGridWidth{32};
   constexpr std::size_t kGridHeight{32};
+  constexpr std::size_t kRecordInterval{60};  // Rendered frames between headless PNGs
+
+  // SDL lives as long as main, every window and the audio device are gone before it shuts down
+  SdlContext sdl(headless ? SDL_INIT_EVENTS | SDL_INIT_TIMER : SDL_INIT_VIDEO);
+  if (!sdl.ok()) { return 1; }
+
+  /*
+   * Map the packed asset bundle once at startup
+   * If it is missing, assets are loaded from the loose files instead
+   */
+  AssetBundle assets;
+  assets.openDefault();
 
-  // Create Renderer instance
-  Renderer renderer(kScreenWidth, kScreenHeight, kGridWidth, kGridHeight);
+#ifdef SNAKE_NETPLAY
+  if (!relayAddress.empty() && !levelPath.empty()) {
+    std::cerr << "Levels are not available online, playing on the open board.\n";
+    levelPath.clear();
+  }
+#endif
+
+  if (headless && sessions > 1) {
+    std::cerr << "Hosting several sessions needs a window, running one headless session.\n";
+    sessions = 1;
+  }
+
+  // A level defines the grid size, mapping it is cheap even for huge levels
+  Level level;
+  std::size_t gridWidth = kGridWidth;
+  std::size_t gridHeight = kGridHeight;
+  if (!levelPath.empty()) {
+    if (!level.openFile(levelPath)) { return 1; }
+    gridWidth = static_cast<std::size_t>(level.width());
+    gridHeight = static_cast<std::size_t>(level.height());
+
+    // Every cell needs at least one pixel of the board to be visible
+    SDL_Point board = SessionHost::boardSize(layout, sessions, kScreenWidth, kScreenHeight);
+    if (level.width() > board.x || level.height() > board.y) {
+      std::cerr << "Level " << levelPath << " is " << level.width() << "x" << level.height()
+                << " cells, too large for a " << board.x << "x" << board.y << " pixel board.\n";
+      return 1;
+    }
+  }
+
+  // One audio device and sound thread, shared by every session of the process
+  if (headless) { audioEnabled = false; }  // No one to listen, and no audio device on CI machines
+  auto makeAudio = [&assets, audioEnabled]() {
+    std::unique_ptr<AudioSink> audioSink;
+    if (audioEnabled) {
+      audioSink = std::make_unique<MixerAudioSink>(assets);
+    } else {
+      audioSink = std::make_unique<NullAudioSink>();
+    }
+    return std::make_shared<AudioSystem>(std::move(audioSink));
+  };
+
+  // Several boards in one process
+  if (sessions > 1) {
+    SessionHost host(layout, sessions, kScreenWidth, kScreenHeight, gridWidth, gridHeight,
+                     makeAudio(), level.isOpen() ? &level : nullptr);
+    host.setPracticeMode(practiceMode);
+    host.run();
+    return 0;
+  }
+
+  // Create the render backend, a window or an offscreen pixel buffer
+  std::unique_ptr<RenderBackend> renderer;
+  if (headless) {
+    auto software = std::make_unique<SoftwareRenderer>(kScreenWidth, kScreenHeight, gridWidth, gridHeight);
+    software->recordFrames(recordPrefix, SoftwareRenderer::ImageFormat::kPng, kRecordInterval);
+    renderer = std::move(software);
+  } else {
+    renderer = std::make_unique<Renderer>(kScreenWidth, kScreenHeight, gridWidth, gridHeight);
+  }
 
   // Create Controller instance
   Controller controller;
 
+#ifdef SNAKE_NETPLAY
+  // Online head-to-head match
+  if (!relayAddress.empty()) {
+    std::size_t colon = relayAddress.rfind(':');
+    unsigned long port = 0;
+    if (colon == std::string::npos || !parseNumber(relayAddress.substr(colon + 1), 0xFFFFul, port)) {
+      std::cerr << "Expected --connect host:port\n";
+      printUsage();
+      return 1;
+    }
+    NetClient client(relayAddress.substr(0, colon), static_cast<std::uint16_t>(port), matchId,
+                     kGridWidth, kGridHeight);
+    NetGame netGame(controller, *renderer, client);
+    netGame.run();
+    return 0;
+  }
+#endif
+
   // Create Game instance
-  Game game(kGridWidth, kGridHeight, std::move(controller), std::move(renderer));
+  Game game(gridWidth, gridHeight, std::move(controller), std::move(renderer), makeAudio());
+
+  game.setPracticeMode(practiceMode);
+  if (level.isOpen()) { game.setLevel(level); }
 
-  // Run the Game
-  game.run();
+  // Run the Game, a headless game has nobody at the console to answer the prompts
+  if (headless) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t frames = game.runUnattended("Headless", headlessFrames);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Rendered " << frames << " frames in " << seconds << " s ("
+              << (seconds > 0.0 ? frames / seconds : 0.0) << " frames/s)\n";
+  } else {
+    game.run();
+  }
 
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+// Move Constructor
+MappedFile::MappedFile(MappedFile &&source) {
+  _data = source._data;
+  _size = source._size;
+
+  // Invalidating source after move operation
+  source._data = nullptr;
+  source._size = 0;
+}
+
+// Move Assignment Operator
+MappedFile &MappedFile::operator=(MappedFile &&source) {
+  if (this == &source) { return *this; }  // To handle self assignment scenario
+
+  close();
+  _data = source._data;
+  _size = source._size;
+
+  // Invalidating source after move operation
+  source._data = nullptr;
+  source._size = 0;
+
+  return *this;
+}
+
+// Returns false if the file is missing, empty or can not be mapped
+bool MappedFile::open(std::string const &path) {
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (INVALID_HANDLE_VALUE == file) { return false; }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (nullptr == mapping) { return false; }
+  void *address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);  // The view keeps the mapping alive
+  if (nullptr == address) { return false; }
+  _size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+  struct stat info;
+  if (fstat(fd, &info) < 0 || info.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  void *address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+  ::close(fd);  // The mapping keeps the file alive
+  if (MAP_FAILED == address) { return false; }
+  _size = static_cast<std::size_t>(info.st_size);
+#endif
+
+  _data = static_cast<const unsigned char *>(address);
+  return true;
+}
+
+void MappedFile::close() {
+  if (nullptr != _data) {
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<unsigned char *>(_data), _size);
+#endif
+  }
+  _data = nullptr;
+  _size = 0;
+}
+
+const unsigned char *MappedFile::data() const {
+  return _data;
+}
+
+std::size_t MappedFile::size() const {
+  return _size;
+}
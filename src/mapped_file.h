@@ -0,0 +1,44 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/*
+ * Read-only memory mapping of a whole file
+ * Pages are only read from disk when they are first touched, so opening
+ * even a very large file costs a few system calls.
+ */
+class MappedFile {
+ public:
+  // Constructor
+  MappedFile() = default;
+
+  // Destructor
+  ~MappedFile();
+
+  /*
+   * Rule of 5 implementation
+   * Adopting a "No Copy, Only Move" memory management policy
+   */
+  MappedFile(const MappedFile &) = delete;             // Delete copy constructor
+  MappedFile &operator=(const MappedFile &) = delete;  // Delete copy assignment operator
+
+  // Move Constructor
+  MappedFile(MappedFile &&source);
+
+  // Move Assignment Operator
+  MappedFile &operator=(MappedFile &&source);
+
+  // Public methods
+  bool open(std::string const &path);
+  void close();
+  const unsigned char *data() const;
+  std::size_t size() const;
+
+ private:
+  const unsigned char *_data{nullptr};
+  std::size_t          _size{0};
+};
+
+#endif
@@ -0,0 +1,230 @@
+#include "net.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "input.h"
+
+namespace Net {
+
+namespace {
+constexpr std::size_t kHeaderSize{6};
+
+void putU32(std::uint8_t *buffer, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) { buffer[i] = static_cast<std::uint8_t>(value >> (8 * i)); }
+}
+
+void putU64(std::uint8_t *buffer, std::uint64_t value) {
+  for (int i = 0; i < 8; ++i) { buffer[i] = static_cast<std::uint8_t>(value >> (8 * i)); }
+}
+
+std::uint32_t getU32(const std::uint8_t *buffer) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) { value |= static_cast<std::uint32_t>(buffer[i]) << (8 * i); }
+  return value;
+}
+
+std::uint64_t getU64(const std::uint8_t *buffer) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) { value |= static_cast<std::uint64_t>(buffer[i]) << (8 * i); }
+  return value;
+}
+}  // namespace
+
+// Serialize a packet into buffer (at least kMaxPacketSize bytes), returns its size
+std::size_t encodePacket(Packet const &packet, std::uint8_t *buffer) {
+  buffer[0] = static_cast<std::uint8_t>(packet.type);
+  buffer[1] = packet.player;
+  putU32(buffer + 2, packet.matchId);
+  std::size_t size = kHeaderSize;
+
+  switch (packet.type) {
+    case PacketType::kStart:
+      putU64(buffer + size, packet.seed);
+      size += 8;
+      break;
+
+    case PacketType::kInput: {
+      std::size_t count = std::min<std::size_t>(packet.inputCount, kMaxInputsPerPacket);
+      putU32(buffer + size, packet.ack);
+      putU32(buffer + size + 4, packet.firstTick);
+      buffer[size + 8] = static_cast<std::uint8_t>(count);
+      size += 9;
+      for (std::size_t i = 0; i < count; i += 2) {
+        std::uint8_t low  = packet.inputs[i] & 0x0F;
+        std::uint8_t high = (i + 1 < count) ? (packet.inputs[i + 1] & 0x0F) : 0;
+        buffer[size++] = static_cast<std::uint8_t>(low | (high << 4));
+      }
+      break;
+    }
+
+    case PacketType::kJoin:
+      break;
+  }
+  return size;
+}
+
+// Parse a received datagram, rejecting anything malformed
+bool decodePacket(const std::uint8_t *buffer, std::size_t size, Packet &packet) {
+  if (size < kHeaderSize) { return false; }
+  packet.type    = static_cast<PacketType>(buffer[0]);
+  packet.player  = buffer[1];
+  packet.matchId = getU32(buffer + 2);
+
+  switch (packet.type) {
+    case PacketType::kJoin:
+      return true;
+
+    case PacketType::kStart:
+      if (size < kHeaderSize + 8) { return false; }
+      packet.seed = getU64(buffer + kHeaderSize);
+      return true;
+
+    case PacketType::kInput: {
+      if (size < kHeaderSize + 9) { return false; }
+      packet.ack        = getU32(buffer + kHeaderSize);
+      packet.firstTick  = getU32(buffer + kHeaderSize + 4);
+      packet.inputCount = buffer[kHeaderSize + 8];
+      if (packet.inputCount > kMaxInputsPerPacket ||
+          size < kHeaderSize + 9 + (packet.inputCount + 1u) / 2) {
+        return false;
+      }
+      const std::uint8_t *packed = buffer + kHeaderSize + 9;
+      for (std::size_t i = 0; i < packet.inputCount; ++i) {
+        packet.inputs[i] = (i % 2 == 0) ? (packed[i / 2] & 0x0F) : (packed[i / 2] >> 4);
+        if (packet.inputs[i] > kMaxInput) { return false; }  // Not a direction, would corrupt steer()
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool resolveAddress(std::string const &host, std::uint16_t port, sockaddr_in &address) {
+  addrinfo hints{};
+  hints.ai_family   = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo *result = nullptr;
+  if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || nullptr == result) {
+    std::cerr << "Could not resolve " << host << "\n";
+    return false;
+  }
+  address = *reinterpret_cast<sockaddr_in *>(result->ai_addr);
+  address.sin_port = htons(port);
+  freeaddrinfo(result);
+  return true;
+}
+
+bool sameAddress(sockaddr_in const &a, sockaddr_in const &b) {
+  return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+}
+
+double nowMs() {
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+UdpSocket::UdpSocket() {
+  _fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (_fd < 0) {
+    std::cerr << "UDP socket could not be created.\n";
+    return;
+  }
+  fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+UdpSocket::~UdpSocket() {
+  if (_fd >= 0) { close(_fd); }
+}
+
+// Move Constructor
+UdpSocket::UdpSocket(UdpSocket &&source) {
+  _fd = source._fd;
+  source._fd = -1;  // Invalidating source after move operation
+}
+
+// Move Assignment Operator
+UdpSocket &UdpSocket::operator=(UdpSocket &&source) {
+  if (this == &source) { return *this; }  // To handle self assignment scenario
+  if (_fd >= 0) { close(_fd); }
+  _fd = source._fd;
+  source._fd = -1;  // Invalidating source after move operation
+  return *this;
+}
+
+// Bind to a local address, port 0 picks a free port
+bool UdpSocket::bind(std::string const &host, std::uint16_t port) {
+  sockaddr_in address{};
+  if (!resolveAddress(host, port, address)) { return false; }
+  if (::bind(_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+    std::cerr << "UDP socket could not be bound to " << host << ":" << port << "\n";
+    return false;
+  }
+  return true;
+}
+
+bool UdpSocket::send(sockaddr_in const &to, const std::uint8_t *data, std::size_t size) {
+  return sendto(_fd, data, size, 0, reinterpret_cast<const sockaddr *>(&to), sizeof(to)) ==
+         static_cast<long>(size);
+}
+
+// Returns the datagram size, or -1 if nothing is pending
+long UdpSocket::receive(std::uint8_t *data, std::size_t capacity, sockaddr_in &from) {
+  socklen_t length = sizeof(from);
+  return recvfrom(_fd, data, capacity, 0, reinterpret_cast<sockaddr *>(&from), &length);
+}
+
+std::uint16_t UdpSocket::port() const {
+  sockaddr_in address{};
+  socklen_t length = sizeof(address);
+  if (getsockname(_fd, reinterpret_cast<sockaddr *>(&address), &length) < 0) { return 0; }
+  return ntohs(address.sin_port);
+}
+
+int UdpSocket::fd() const {
+  return _fd;
+}
+
+LinkConditioner::LinkConditioner(LinkConditions conditions, std::uint64_t seed)
+    : _conditions(conditions), _random(seed) {}
+
+void LinkConditioner::send(UdpSocket &socket, sockaddr_in const &to,
+                           const std::uint8_t *data, std::size_t size) {
+  if (_conditions.lossRate > 0.0 && uniform_() < _conditions.lossRate) {
+    ++_dropped;
+    return;
+  }
+  double delay = _conditions.latencyMs + (2.0 * uniform_() - 1.0) * _conditions.jitterMs;
+  if (delay <= 0.0) {
+    socket.send(to, data, size);
+    return;
+  }
+  _pending.push_back(Delayed{nowMs() + delay, to, std::vector<std::uint8_t>(data, data + size)});
+}
+
+// Send every delayed packet that is due
+void LinkConditioner::flush(UdpSocket &socket) {
+  double now = nowMs();
+  auto due = std::partition(_pending.begin(), _pending.end(),
+                            [now](Delayed const &packet) { return packet.deliverAt > now; });
+  for (auto it = due; it != _pending.end(); ++it) {
+    socket.send(it->to, it->bytes.data(), it->bytes.size());
+  }
+  _pending.erase(due, _pending.end());
+}
+
+std::uint64_t LinkConditioner::dropped() const {
+  return _dropped;
+}
+
+// Uniform number in [0, 1)
+double LinkConditioner::uniform_() {
+  return _random.next() / 4294967296.0;
+}
+
+}  // namespace Net
@@ -0,0 +1,119 @@
+#ifndef NET_H
+#define NET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include "random.h"
+
+/*
+ * Wire format shared by the game clients and the relay
+ * Every packet starts with a 6 byte header: type, player, match id.
+ *
+ *   kJoin   : header only, sent by a client until the match starts
+ *   kStart  : header + 8 byte seed, sent by the relay to both players
+ *   kInput  : header + ack tick + first tick + input count + packed inputs
+ *
+ * Inputs are 4 bits each, two per byte, and every input packet repeats
+ * all inputs the peer has not acknowledged yet, so a lost packet is
+ * recovered by the next one without retransmission logic. Integers are
+ * little-endian.
+ */
+namespace Net {
+
+enum class PacketType : std::uint8_t { kJoin = 1, kStart = 2, kInput = 3 };
+
+constexpr std::size_t kMaxInputsPerPacket{128};  // Counted in one byte, must stay below 256
+constexpr std::size_t kMaxPacketSize{6 + 9 + kMaxInputsPerPacket / 2};
+
+struct Packet {
+  PacketType    type{PacketType::kJoin};
+  std::uint8_t  player{0};
+  std::uint32_t matchId{0};
+  std::uint64_t seed{0};                // kStart
+  std::uint32_t ack{0};                 // kInput: sender has all peer inputs before this tick
+  std::uint32_t firstTick{0};           // kInput: tick of inputs[0]
+  std::uint8_t  inputCount{0};          // kInput
+  std::uint8_t  inputs[kMaxInputsPerPacket]{};
+};
+
+std::size_t encodePacket(Packet const &packet, std::uint8_t *buffer);
+bool decodePacket(const std::uint8_t *buffer, std::size_t size, Packet &packet);
+
+// Resolve an IPv4 host name, e.g. "127.0.0.1" or "localhost"
+bool resolveAddress(std::string const &host, std::uint16_t port, sockaddr_in &address);
+bool sameAddress(sockaddr_in const &a, sockaddr_in const &b);
+
+// Milliseconds on a monotonic clock
+double nowMs();
+
+// Non-blocking IPv4 UDP socket
+class UdpSocket {
+ public:
+  // Constructor
+  UdpSocket();
+
+  // Destructor
+  ~UdpSocket();
+
+  /*
+   * Rule of 5 implementation
+   * Adopting a "No Copy, Only Move" memory management policy
+   */
+  UdpSocket(const UdpSocket &) = delete;
+  UdpSocket &operator=(const UdpSocket &) = delete;
+  UdpSocket(UdpSocket &&source);
+  UdpSocket &operator=(UdpSocket &&source);
+
+  // Public methods
+  bool bind(std::string const &host, std::uint16_t port);
+  bool send(sockaddr_in const &to, const std::uint8_t *data, std::size_t size);
+  long receive(std::uint8_t *data, std::size_t capacity, sockaddr_in &from);
+  std::uint16_t port() const;
+  int fd() const;
+
+ private:
+  int _fd;
+};
+
+// Simulated network conditions for loopback testing
+struct LinkConditions {
+  double latencyMs{0.0};  // One way delay
+  double jitterMs{0.0};   // Uniform +/- variation of the delay, may reorder packets
+  double lossRate{0.0};   // Fraction of packets dropped, 0..1
+};
+
+/*
+ * Sends packets through a UdpSocket after a simulated delay, or drops
+ * them. Conditions of zero pass packets straight through.
+ */
+class LinkConditioner {
+ public:
+  // Constructor
+  LinkConditioner(LinkConditions conditions, std::uint64_t seed);
+
+  // Public methods
+  void send(UdpSocket &socket, sockaddr_in const &to, const std::uint8_t *data, std::size_t size);
+  void flush(UdpSocket &socket);
+  std::uint64_t dropped() const;
+
+ private:
+  struct Delayed {
+    double                    deliverAt;
+    sockaddr_in               to;
+    std::vector<std::uint8_t> bytes;
+  };
+
+  double uniform_();
+
+  LinkConditions       _conditions;
+  Random               _random;
+  std::vector<Delayed> _pending{};
+  std::uint64_t        _dropped{0};
+};
+
+}  // namespace Net
+
+#endif
@@ -0,0 +1,164 @@
+#include "netclient.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+NetClient::NetClient(std::string const &relayHost, std::uint16_t relayPort,
+                     std::uint32_t matchId, std::size_t gridWidth, std::size_t gridHeight,
+                     Net::LinkConditions conditions, std::uint64_t linkSeed)
+    : _matchId(matchId),
+      _gridWidth(gridWidth),
+      _gridHeight(gridHeight),
+      _link(conditions, linkSeed) {
+  _relayValid = Net::resolveAddress(relayHost, relayPort, _relay);
+}
+
+/*
+ * Ask the relay to join the match and wait until the second player shows up
+ * Blocks the calling thread; interactive callers use join() once per frame.
+ */
+bool NetClient::connect(double timeoutMs) {
+  double deadline = Net::nowMs() + timeoutMs;
+  while (!join() && _relayValid && Net::nowMs() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return connected();
+}
+
+/*
+ * One non-blocking step of joining the match, returns whether it started
+ * Join requests are repeated, so a lost datagram only delays the start.
+ */
+bool NetClient::join() {
+  if (!_relayValid) { return false; }
+  if (_session) { return true; }
+
+  std::uint8_t buffer[Net::kMaxPacketSize];
+  if (Net::nowMs() >= _nextJoin) {
+    Net::Packet join;
+    join.type    = Net::PacketType::kJoin;
+    join.matchId = _matchId;
+    _link.send(_socket, _relay, buffer, Net::encodePacket(join, buffer));
+    _nextJoin = Net::nowMs() + kJoinInterval;
+  }
+  _link.flush(_socket);
+
+  sockaddr_in from{};
+  long size;
+  while ((size = _socket.receive(buffer, sizeof(buffer), from)) > 0) {
+    Net::Packet packet;
+    if (Net::decodePacket(buffer, static_cast<std::size_t>(size), packet) &&
+        packet.type == Net::PacketType::kStart && packet.matchId == _matchId &&
+        packet.player < kVersusPlayers) {
+      _session = std::make_unique<RollbackSession>(_gridWidth, _gridHeight, packet.seed,
+                                                   packet.player);
+      _lastHeard = Net::nowMs();
+      break;
+    }
+  }
+  return connected();
+}
+
+/*
+ * Run one iteration of the network game loop
+ * Returns whether a simulation tick was made; false means the session is
+ * waiting for the remote player's inputs.
+ */
+bool NetClient::tick(PlayerInput input) {
+  poll();
+
+  if (input != kNoInput) { _pendingInput = input; }
+  if (_session->addLocalInput(_pendingInput)) { _pendingInput = kNoInput; }
+
+  bool advanced = _session->advance();
+  sendInputs_();
+  _link.flush(_socket);
+  return advanced;
+}
+
+// Feed every received remote input into the session
+void NetClient::poll() {
+  std::uint8_t buffer[Net::kMaxPacketSize];
+  sockaddr_in from{};
+  long size;
+  while ((size = _socket.receive(buffer, sizeof(buffer), from)) > 0) {
+    Net::Packet packet;
+    if (!Net::decodePacket(buffer, static_cast<std::size_t>(size), packet) ||
+        packet.type != Net::PacketType::kInput || packet.matchId != _matchId ||
+        packet.player == _session->localPlayer()) {
+      continue;
+    }
+    _peerAck = std::max(_peerAck, packet.ack);
+    _lastHeard = Net::nowMs();
+    for (std::size_t i = 0; i < packet.inputCount; ++i) {
+      _session->addRemoteInput(packet.firstTick + static_cast<std::uint32_t>(i), packet.inputs[i]);
+    }
+  }
+  _link.flush(_socket);
+}
+
+/*
+ * Exchange inputs without simulating a new tick, e.g. while waiting for
+ * the final inputs of a match. Pending rollbacks are carried out.
+ */
+void NetClient::sync() {
+  poll();
+  _session->synchronize();
+  sendInputs_();
+  _link.flush(_socket);
+}
+
+bool NetClient::connected() const {
+  return static_cast<bool>(_session);
+}
+
+// Outgoing packets lost to the simulated link conditions
+std::uint64_t NetClient::droppedPackets() const {
+  return _link.dropped();
+}
+
+// Time the peer was last heard from, on the Net::nowMs() clock
+double NetClient::lastHeardMs() const {
+  return _lastHeard;
+}
+
+RollbackSession const &NetClient::session() const {
+  return *_session;
+}
+
+RollbackSession &NetClient::session() {
+  return *_session;
+}
+
+/*
+ * Each side runs at most kMaxRollback + kInputDelay + 1 ticks of local input
+ * ahead of the inputs it has confirmed, so the unacknowledged window is at
+ * most twice that. Skipping inputs at the start of the window would lose
+ * them for good, so every one of them must fit into a single packet.
+ */
+static_assert(Net::kMaxInputsPerPacket >=
+                  2 * (RollbackSession::kMaxRollback + RollbackSession::kInputDelay + 1),
+              "An input packet must hold every input the peer can be missing");
+static_assert(Net::kMaxInputsPerPacket < 256, "The input count is sent in one byte");
+
+// Send all local inputs the peer has not acknowledged, newest last
+void NetClient::sendInputs_() {
+  std::uint32_t end = _session->localInputEnd();
+  std::uint32_t first = std::max(_peerAck, end > Net::kMaxInputsPerPacket
+                                               ? end - static_cast<std::uint32_t>(Net::kMaxInputsPerPacket)
+                                               : 0u);
+  Net::Packet packet;
+  packet.type       = Net::PacketType::kInput;
+  packet.player     = static_cast<std::uint8_t>(_session->localPlayer());
+  packet.matchId    = _matchId;
+  packet.ack        = _session->remoteInputEnd();
+  packet.firstTick  = first;
+  packet.inputCount = static_cast<std::uint8_t>(end > first ? end - first : 0);
+  for (std::uint32_t tick = first; tick < end; ++tick) {
+    packet.inputs[tick - first] = _session->localInput(tick);
+  }
+
+  std::uint8_t buffer[Net::kMaxPacketSize];
+  _link.send(_socket, _relay, buffer, Net::encodePacket(packet, buffer));
+}
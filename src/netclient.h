@@ -0,0 +1,58 @@
+#ifndef NETCLIENT_H
+#define NETCLIENT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "input.h"
+#include "net.h"
+#include "rollback.h"
+
+/*
+ * One player's connection to a match through the relay
+ * Owns the rollback session: every tick it schedules the local input,
+ * advances the simulation and sends all inputs the peer has not
+ * acknowledged yet.
+ */
+class NetClient {
+ public:
+  // Constructor
+  NetClient(std::string const &relayHost, std::uint16_t relayPort, std::uint32_t matchId,
+            std::size_t gridWidth, std::size_t gridHeight,
+            Net::LinkConditions conditions = Net::LinkConditions{}, std::uint64_t linkSeed = 1);
+
+  // Public methods
+  bool connect(double timeoutMs);
+  bool join();
+  bool tick(PlayerInput input);
+  void poll();
+  void sync();
+  bool connected() const;
+  std::uint64_t droppedPackets() const;
+  double lastHeardMs() const;
+  RollbackSession const &session() const;
+  RollbackSession &session();
+
+  // Public data
+  const double kJoinInterval{100.0};  // In ms, between join requests while waiting for a match
+
+ private:
+  // Private methods
+  void sendInputs_();
+
+  // Private data
+  Net::UdpSocket                   _socket;
+  sockaddr_in                      _relay{};
+  bool                             _relayValid{false};
+  double                           _nextJoin{0.0};           // When to repeat the join request
+  std::uint32_t                    _matchId;
+  std::size_t                      _gridWidth;
+  std::size_t                      _gridHeight;
+  Net::LinkConditioner             _link;
+  std::unique_ptr<RollbackSession> _session;
+  std::uint32_t                    _peerAck{0};              // Peer has our inputs before this tick
+  PlayerInput                      _pendingInput{kNoInput};  // Held back while the session stalls
+  double                           _lastHeard{0.0};          // When the peer's last packet arrived
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "netgame.h"
+#include <iostream>
+
+NetGame::NetGame(Controller &controller, RenderBackend &renderer, NetClient &client)
+    : _controller(controller), _renderer(renderer), _client(client) {}
+
+void NetGame::run() {
+  std::cout << "Waiting for an opponent to join the match..." << std::endl;
+  if (!waitForOpponent_()) { return; }
+  std::cout << "Match started! You are the snake with the "
+            << (_client.session().localPlayer() == 0 ? "blue" : "green") << " head." << std::endl;
+
+  Uint32 titleTimestamp = SDL_GetTicks();
+  Uint32 gameOverTimestamp = 0;
+  std::uint32_t finishedAt = 0;  // Tick at which the match was first seen finished, 0 while in play
+  bool running = true;
+
+  while (running) {
+    Uint32 frameStart = SDL_GetTicks();
+
+    // Input, Update, Render - the inputs of both players meet in the rollback session
+    PlayerInput input = _controller.sampleInput(running);
+    _client.tick(input);
+    if (_client.session().failed()) {
+      std::cerr << "The match state outgrew its snapshots, the match cannot continue.\n";
+      break;
+    }
+    VersusSimulation const &simulation = _client.session().simulation();
+    _renderer.render(simulation.snake(0), simulation.snake(1), simulation.food());
+
+    Uint32 frameEnd = SDL_GetTicks();
+
+    /*
+     * A finished board may still rest on predicted remote inputs, and a late
+     * input can roll it back into play. The result only counts once every
+     * remote input up to the tick it was seen finished has arrived; both
+     * peers then agree on it. Inputs keep flowing for kGameOverDuration
+     * afterwards so the peer can confirm it too.
+     */
+    RollbackSession const &session = _client.session();
+    if (simulation.finished()) {
+      if (finishedAt == 0) { finishedAt = session.currentTick(); }
+      if (!_resultConfirmed && session.remoteInputEnd() >= finishedAt) {
+        _resultConfirmed = true;
+        gameOverTimestamp = frameEnd;
+      }
+      if (_resultConfirmed && frameEnd - gameOverTimestamp >= kGameOverDuration) { running = false; }
+    } else {
+      finishedAt = 0;
+    }
+
+    // A peer that stopped sending has left, its inputs will never arrive
+    if (!_resultConfirmed && Net::nowMs() - _client.lastHeardMs() >= kPeerTimeout) {
+      _opponentLeft = true;
+      running = false;
+    }
+
+    // After every second, update the window title.
+    if (frameEnd - titleTimestamp >= 1000) {
+      updateWindowTitle_();
+      titleTimestamp = frameEnd;
+    }
+
+    Uint32 frameDuration = frameEnd - frameStart;
+    if (frameDuration < kTargetFrameDuration) {
+      SDL_Delay(kTargetFrameDuration - frameDuration);
+    }
+  }
+
+  displayResult_();
+}
+
+/*
+ * Join the match while keeping the window responsive
+ * Returns false if no opponent joined in time or the player quit.
+ */
+bool NetGame::waitForOpponent_() {
+  _renderer.updateWindowTitle("Waiting for an opponent...");
+  Uint32 start = SDL_GetTicks();
+  bool running = true;
+
+  while (!_client.join()) {
+    _controller.sampleInput(running);  // Keys pressed while waiting are dropped
+    if (!running) { return false; }
+    if (SDL_GetTicks() - start >= kConnectTimeout) {
+      std::cerr << "No opponent joined the match.\n";
+      return false;
+    }
+    SDL_Delay(kTargetFrameDuration);
+  }
+  return true;
+}
+
+void NetGame::updateWindowTitle_() {
+  RollbackSession const &session = _client.session();
+  int local = session.localPlayer();
+  std::string title{"You: " + std::to_string(session.simulation().score(local)) +
+                    "   Opponent: " + std::to_string(session.simulation().score(1 - local)) +
+                    "   Rollbacks: " + std::to_string(session.stats().rollbacks)};
+  _renderer.updateWindowTitle(title);
+}
+
+// Display the result of the match and how much rollback work it took
+void NetGame::displayResult_() {
+  RollbackSession const &session = _client.session();
+  VersusSimulation const &simulation = session.simulation();
+  int local = session.localPlayer();
+
+  std::cout << "MATCH OVER!" << "\n";
+  if (session.failed()) {
+    std::cout << "The match was aborted, its state could not be kept in sync." << "\n";
+  } else if (_opponentLeft) {
+    std::cout << "Your opponent left the match." << "\n";
+  } else if (!_resultConfirmed) {
+    std::cout << "You left the match." << "\n";
+  } else if (simulation.winner() < 0) {
+    std::cout << "It's a draw!" << "\n";
+  } else if (simulation.winner() == local) {
+    std::cout << "You won! \U0001F4AA" << "\n";
+  } else {
+    std::cout << "You lost!" << "\n";
+  }
+  std::cout << "Your score: " << simulation.score(local)
+            << ", opponent's score: " << simulation.score(1 - local) << "\n";
+
+  RollbackStats const &stats = session.stats();
+  std::cout << "Rollbacks: " << stats.rollbacks << " in " << stats.ticks << " ticks, "
+            << stats.resimulatedTicks << " ticks re-simulated in "
+            << stats.resimulationMs << " ms (max " << stats.maxResimulationMs << " ms), "
+            << stats.stalls << " stalls" << std::endl;
+}
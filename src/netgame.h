@@ -0,0 +1,44 @@
+#ifndef NETGAME_H
+#define NETGAME_H
+
+#include "SDL.h"
+#include "controller.h"
+#include "netclient.h"
+#include "render_backend.h"
+
+/*
+ * Game loop of an online head-to-head match
+ * Keyboard input is not applied to a snake directly: it is sampled once
+ * per tick and handed to the NetClient, which schedules it on the shared
+ * tick-indexed timeline of the match.
+ */
+class NetGame {
+ public:
+  // Constructor
+  NetGame(Controller &controller, RenderBackend &renderer, NetClient &client);
+
+  // Public Methods
+  void run();
+
+  // Public Data
+  const std::size_t kFramesPerSecond{60};
+  const std::size_t kTargetFrameDuration{1000 / kFramesPerSecond};
+  const Uint32      kConnectTimeout{60000};    // In ms, how long to wait for an opponent
+  const Uint32      kGameOverDuration{2000};   // In ms, keeps inputs flowing to the peer
+  const double      kPeerTimeout{5000.0};      // In ms, silence after which the opponent has left
+
+ private:
+  // Private methods
+  bool waitForOpponent_();
+  void updateWindowTitle_();
+  void displayResult_();
+
+  // Private data
+  Controller    &_controller;
+  RenderBackend &_renderer;
+  NetClient     &_client;
+  bool           _resultConfirmed{false};  // Every remote input up to the end of the match arrived
+  bool           _opponentLeft{false};
+};
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * SnakeNetSim - runs online matches entirely over loopback
+ *
+ * Starts a relay and two scripted clients per match in one process, with
+ * simulated latency, jitter and packet loss on every client link. When
+ * the matches end it checks that both peers of each match reached the
+ * same state and reports how much rollback work that took.
+ *
+ * Usage: SnakeNetSim [--matches N] [--ticks N] [--latency ms] [--jitter ms] [--loss rate]
+ * Exits with a non-zero status if a match fails to start or desyncs.
+ */
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "netclient.h"
+#include "relay.h"
+
+namespace {
+
+constexpr std::size_t kGridWidth{32};
+constexpr std::size_t kGridHeight{32};
+constexpr double      kTickMs{1000.0 / 60.0};
+constexpr double      kTimeoutMs{10000.0};
+
+struct ClientResult {
+  bool          ok{false};
+  std::uint32_t checksum{0};
+  RollbackStats stats{};
+  std::uint64_t dropped{0};
+};
+
+// Play one side of a match with pseudo-random steering, in real time
+void playMatch(std::uint16_t relayPort, std::uint32_t matchId, int side, std::uint32_t ticks,
+               Net::LinkConditions conditions, ClientResult &result) {
+  std::uint64_t seed = matchId * 2u + static_cast<std::uint64_t>(side) + 1u;
+  NetClient client("127.0.0.1", relayPort, matchId, kGridWidth, kGridHeight, conditions, seed);
+  if (!client.connect(kTimeoutMs)) { return; }
+
+  Random script(seed * 7919u);
+  auto next = std::chrono::steady_clock::now();
+  double deadline = Net::nowMs() + ticks * kTickMs + kTimeoutMs;
+
+  while (client.session().currentTick() < ticks && !client.session().failed() &&
+         Net::nowMs() < deadline) {
+    PlayerInput input = kNoInput;
+    if (script.next() % 8 == 0) {
+      input = encodeDirection(static_cast<Snake::Direction>(script.next() % 4));
+    }
+    client.tick(input);
+    next += std::chrono::microseconds(static_cast<long>(kTickMs * 1000.0));
+    std::this_thread::sleep_until(next);
+  }
+
+  // Keep exchanging inputs until every remote input of the match is confirmed
+  while (client.session().remoteInputEnd() < ticks && !client.session().failed() &&
+         Net::nowMs() < deadline) {
+    client.sync();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  client.sync();
+
+  // Linger briefly so the peer gets our final inputs even if packets were lost
+  double linger = Net::nowMs() + 500.0;
+  while (Net::nowMs() < linger) {
+    client.sync();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  RollbackSession const &session = client.session();
+  result.ok       = !session.failed() && session.currentTick() == ticks &&
+                    session.remoteInputEnd() >= ticks;
+  result.checksum = session.simulation().checksum();
+  result.stats    = session.stats();
+  result.dropped  = client.droppedPackets();
+}
+
+void printStats(std::uint32_t matchId, int side, ClientResult const &result) {
+  RollbackStats const &stats = result.stats;
+  double perTick = stats.ticks ? static_cast<double>(stats.rollbacks) / stats.ticks : 0.0;
+  double depth   = stats.rollbacks ? static_cast<double>(stats.resimulatedTicks) / stats.rollbacks : 0.0;
+  double cost    = stats.rollbacks ? stats.resimulationMs / stats.rollbacks : 0.0;
+  std::cout << "  match " << matchId << " player " << side
+            << ": rollbacks " << stats.rollbacks
+            << " (" << std::fixed << std::setprecision(1) << perTick * 100.0 << "% of ticks)"
+            << ", avg depth " << depth << " ticks, max " << stats.maxRollbackTicks
+            << ", avg cost " << std::setprecision(3) << cost << " ms, max "
+            << stats.maxResimulationMs << " ms, stalls " << stats.stalls
+            << ", dropped " << result.dropped << " packets\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::uint32_t matches = 1;
+  std::uint32_t ticks = 600;
+  Net::LinkConditions conditions;
+  conditions.latencyMs = 50.0;
+  conditions.jitterMs  = 10.0;
+  conditions.lossRate  = 0.05;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string arg{argv[i]};
+    std::string value{argv[i + 1]};
+    if (arg == "--matches")      { matches = static_cast<std::uint32_t>(std::stoul(value)); }
+    else if (arg == "--ticks")   { ticks = static_cast<std::uint32_t>(std::stoul(value)); }
+    else if (arg == "--latency") { conditions.latencyMs = std::stod(value); }
+    else if (arg == "--jitter")  { conditions.jitterMs = std::stod(value); }
+    else if (arg == "--loss")    { conditions.lossRate = std::stod(value); }
+    else {
+      std::cerr << "Unknown option " << arg << "\n";
+      return 1;
+    }
+  }
+
+  Relay relay("127.0.0.1", 0);
+  if (!relay.ok()) { return 1; }
+  std::atomic<bool> relayRunning{true};
+  std::thread relayThread(&Relay::run, &relay, std::cref(relayRunning));
+
+  std::cout << "Simulating " << matches << " match(es) of " << ticks << " ticks, latency "
+            << conditions.latencyMs << " ms, jitter " << conditions.jitterMs << " ms, loss "
+            << conditions.lossRate * 100.0 << "%" << std::endl;
+
+  std::vector<ClientResult> results(matches * kVersusPlayers);
+  std::vector<std::thread> clients;
+  for (std::uint32_t m = 0; m < matches; ++m) {
+    for (int side = 0; side < kVersusPlayers; ++side) {
+      clients.emplace_back(playMatch, relay.port(), m, side, ticks, conditions,
+                           std::ref(results[m * kVersusPlayers + side]));
+    }
+  }
+  for (std::thread &client : clients) { client.join(); }
+
+  relayRunning = false;
+  relayThread.join();
+
+  bool success = true;
+  for (std::uint32_t m = 0; m < matches; ++m) {
+    ClientResult const &first  = results[m * kVersusPlayers];
+    ClientResult const &second = results[m * kVersusPlayers + 1];
+    bool inSync = first.ok && second.ok && first.checksum == second.checksum;
+    success = success && inSync;
+    std::cout << "match " << m << ": "
+              << (inSync ? "in sync" : (first.ok && second.ok ? "DESYNC" : "FAILED"))
+              << " (checksums " << std::hex << first.checksum << " / " << second.checksum
+              << std::dec << ")\n";
+    printStats(m, 0, first);
+    printStats(m, 1, second);
+  }
+  return success ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#ifndef POWERUP_H
+#define POWERUP_H
+
+#include <array>
+#include <cstdint>
+#include "SDL.h"
+
+// A timed pickup lying on the board
+struct PowerUp {
+  // Define PowerUp Type
+  enum class Type : std::uint8_t { kBonus, kSpeedBoost, kShrink };
+
+  Type          type;
+  bool          active;     // Whether the pickup is on the board
+  SDL_Point     position;
+  std::uint32_t expiresAt;  // Tick at which it disappears
+};
+
+constexpr std::size_t kMaxPowerUps{3};  // On the board at the same time
+using PowerUps = std::array<PowerUp, kMaxPowerUps>;
+
+#endif
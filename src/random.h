@@ -0,0 +1,49 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/*
+ * Small deterministic random number generator (PCG32)
+ * Unlike std::mt19937 with std::uniform_int_distribution its state is
+ * 16 trivially copyable bytes and its output is identical on every
+ * platform, so it can be captured in snapshots and replayed.
+ */
+class Random {
+ public:
+  // Constructor
+  explicit Random(std::uint64_t seed = 0x853c49e6748fea9bULL) { reseed(seed); }
+
+  void reseed(std::uint64_t seed) {
+    _state = 0;
+    next();
+    _state += seed;
+    next();
+  }
+
+  std::uint32_t next() {
+    std::uint64_t previous = _state;
+    _state = previous * 6364136223846793005ULL + kIncrement;
+    std::uint32_t xorShifted = static_cast<std::uint32_t>(((previous >> 18u) ^ previous) >> 27u);
+    std::uint32_t rotation = static_cast<std::uint32_t>(previous >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+  }
+
+  // Uniformly distributed integer in [low, high], without modulo bias
+  int uniform(int low, int high) {
+    std::uint32_t range = static_cast<std::uint32_t>(high - low) + 1u;
+    if (range == 0u) { return static_cast<int>(next()); }  // Full 32 bit range
+    std::uint32_t threshold = (0u - range) % range;
+    std::uint32_t value;
+    do {
+      value = next();
+    } while (value < threshold);
+    return low + static_cast<int>(value % range);
+  }
+
+ private:
+  static constexpr std::uint64_t kIncrement{1442695040888963407ULL};
+  std::uint64_t _state;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "relay.h"
+#include <iostream>
+#include <random>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+Relay::Relay(std::string const &host, std::uint16_t port)
+    : _random(std::random_device{}()) {
+  if (!_socket.bind(host, port)) { return; }
+
+  _epollFd = epoll_create1(0);
+  _timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+  if (_epollFd < 0 || _timerFd < 0) {
+    std::cerr << "Relay could not create its event loop.\n";
+    return;
+  }
+
+  // Check for idle matches once per second
+  itimerspec interval{};
+  interval.it_interval.tv_sec = 1;
+  interval.it_value.tv_sec    = 1;
+  timerfd_settime(_timerFd, 0, &interval, nullptr);
+
+  epoll_event event{};
+  event.events  = EPOLLIN;
+  event.data.fd = _socket.fd();
+  epoll_ctl(_epollFd, EPOLL_CTL_ADD, _socket.fd(), &event);
+  event.data.fd = _timerFd;
+  epoll_ctl(_epollFd, EPOLL_CTL_ADD, _timerFd, &event);
+  _ok = true;
+}
+
+Relay::~Relay() {
+  if (_timerFd >= 0) { close(_timerFd); }
+  if (_epollFd >= 0) { close(_epollFd); }
+}
+
+bool Relay::ok() const {
+  return _ok;
+}
+
+// Serve matches until running turns false (checked at least every 100 ms)
+void Relay::run(std::atomic<bool> const &running) {
+  epoll_event events[8];
+  while (running) {
+    int count = epoll_wait(_epollFd, events, 8, 100);
+    for (int i = 0; i < count; ++i) {
+      if (events[i].data.fd == _timerFd) {
+        std::uint64_t expirations;
+        while (read(_timerFd, &expirations, sizeof(expirations)) > 0) {}
+        expireMatches_();
+      } else {
+        receiveAll_();
+      }
+    }
+  }
+}
+
+std::uint16_t Relay::port() const {
+  return _socket.port();
+}
+
+std::size_t Relay::matchCount() const {
+  return _matches.size();
+}
+
+void Relay::receiveAll_() {
+  std::uint8_t buffer[Net::kMaxPacketSize];
+  sockaddr_in from{};
+  long size;
+  while ((size = _socket.receive(buffer, sizeof(buffer), from)) > 0) {
+    handlePacket_(buffer, static_cast<std::size_t>(size), from);
+  }
+}
+
+void Relay::handlePacket_(const std::uint8_t *data, std::size_t size, sockaddr_in const &from) {
+  Net::Packet packet;
+  if (!Net::decodePacket(data, size, packet)) { return; }
+
+  if (packet.type == Net::PacketType::kJoin) {
+    Match &match = _matches[packet.matchId];
+    match.lastActivity = Net::nowMs();
+
+    // A repeated join means our start packet got lost
+    for (int p = 0; p < match.joined; ++p) {
+      if (Net::sameAddress(match.players[p], from)) {
+        if (match.joined == 2) { sendStart_(match, packet.matchId, p); }
+        return;
+      }
+    }
+    if (match.joined == 2) { return; }  // Match is full
+
+    match.players[match.joined++] = from;
+    if (match.joined == 2) {
+      match.seed = (static_cast<std::uint64_t>(_random.next()) << 32) | _random.next();
+      sendStart_(match, packet.matchId, 0);
+      sendStart_(match, packet.matchId, 1);
+    }
+    return;
+  }
+
+  // Forward inputs verbatim to the other player of the match
+  if (packet.type == Net::PacketType::kInput && packet.player < 2) {
+    auto it = _matches.find(packet.matchId);
+    if (it == _matches.end() || it->second.joined != 2) { return; }
+    Match &match = it->second;
+    if (!Net::sameAddress(match.players[packet.player], from)) { return; }
+    match.lastActivity = Net::nowMs();
+    _socket.send(match.players[1 - packet.player], data, size);
+  }
+}
+
+void Relay::sendStart_(Match const &match, std::uint32_t matchId, int player) {
+  Net::Packet start;
+  start.type    = Net::PacketType::kStart;
+  start.player  = static_cast<std::uint8_t>(player);
+  start.matchId = matchId;
+  start.seed    = match.seed;
+  std::uint8_t buffer[Net::kMaxPacketSize];
+  _socket.send(match.players[player], buffer, Net::encodePacket(start, buffer));
+}
+
+void Relay::expireMatches_() {
+  double now = Net::nowMs();
+  for (auto it = _matches.begin(); it != _matches.end();) {
+    if (now - it->second.lastActivity > kMatchTimeout) {
+      it = _matches.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef RELAY_H
+#define RELAY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "net.h"
+#include "random.h"
+
+/*
+ * Match relay server
+ * Pairs up the first two clients that join a match id, hands both the
+ * match seed and forwards their input packets to each other. Any number
+ * of matches share one UDP socket and one epoll loop; the relay never
+ * simulates anything, so its cost per packet is a hash lookup and a send.
+ */
+class Relay {
+ public:
+  // Constructor
+  Relay(std::string const &host, std::uint16_t port);
+
+  // Destructor
+  ~Relay();
+
+  Relay(const Relay &) = delete;
+  Relay &operator=(const Relay &) = delete;
+
+  // Public methods
+  bool ok() const;
+  void run(std::atomic<bool> const &running);
+  std::uint16_t port() const;
+  std::size_t matchCount() const;
+
+  // Public data
+  const double kMatchTimeout{30000.0};  // In ms, a match without traffic is dropped
+
+ private:
+  struct Match {
+    sockaddr_in   players[2]{};
+    int           joined{0};
+    std::uint64_t seed{0};
+    double        lastActivity{0.0};
+  };
+
+  // Private methods
+  void receiveAll_();
+  void handlePacket_(const std::uint8_t *data, std::size_t size, sockaddr_in const &from);
+  void sendStart_(Match const &match, std::uint32_t matchId, int player);
+  void expireMatches_();
+
+  // Private data
+  Net::UdpSocket _socket;
+  int            _epollFd{-1};
+  int            _timerFd{-1};
+  bool           _ok{false};
+  Random         _random;
+  std::unordered_map<std::uint32_t, Match> _matches{};
+};
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * SnakeRelay - relay server for online head-to-head matches
+ *
+ * Usage: SnakeRelay [port]
+ */
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include "relay.h"
+
+namespace {
+std::atomic<bool> gRunning{true};
+
+void stop(int) {
+  gRunning = false;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  constexpr std::uint16_t kDefaultPort{7777};
+  std::uint16_t port = (argc > 1) ? static_cast<std::uint16_t>(std::stoi(argv[1])) : kDefaultPort;
+
+  Relay relay("0.0.0.0", port);
+  if (!relay.ok()) { return 1; }
+
+  std::signal(SIGINT, stop);
+  std::signal(SIGTERM, stop);
+
+  std::cout << "Relay listening on UDP port " << relay.port() << std::endl;
+  relay.run(gRunning);
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include "render_backend.h"
+
+SDL_Color RenderBackend::cellColor(Cell cell) {
+  switch (cell) {
+    case Cell::kEmpty:      return SDL_Color{0x1E, 0x1E, 0x1E, 0xFF};
+    case Cell::kFood:       return SDL_Color{0xFF, 0xCC, 0x00, 0xFF};  // yellow
+    case Cell::kBody:       return SDL_Color{0xFF, 0xFF, 0xFF, 0xFF};  // white
+    case Cell::kHead:       return SDL_Color{0x00, 0x7A, 0xCC, 0xFF};  // blue
+    case Cell::kSecondHead: return SDL_Color{0x2E, 0xB8, 0x4E, 0xFF};  // green
+    case Cell::kDeadHead:   return SDL_Color{0xFF, 0x00, 0x00, 0xFF};  // red
+    case Cell::kBonus:      return SDL_Color{0xD0, 0x3C, 0xD0, 0xFF};  // magenta
+    case Cell::kBoost:      return SDL_Color{0x3C, 0xD0, 0xD0, 0xFF};  // cyan
+    case Cell::kShrink:     return SDL_Color{0xFF, 0x8C, 0x00, 0xFF};  // orange
+    case Cell::kWall:       return SDL_Color{0x6E, 0x6E, 0x6E, 0xFF};  // grey
+    case Cell::kPortal:     return SDL_Color{0x8A, 0x2B, 0xE2, 0xFF};  // violet
+  }
+  return SDL_Color{0x1E, 0x1E, 0x1E, 0xFF};
+}
+
+RenderBackend::Cell RenderBackend::powerUpCell(PowerUp::Type type) {
+  switch (type) {
+    case PowerUp::Type::kBonus:      return Cell::kBonus;
+    case PowerUp::Type::kSpeedBoost: return Cell::kBoost;
+    case PowerUp::Type::kShrink:     return Cell::kShrink;
+  }
+  return Cell::kEmpty;
+}
+
+// What a cell shows when nothing is on it
+RenderBackend::Cell RenderBackend::backgroundCell(Level const *level, SDL_Point const &point) {
+  if (nullptr == level) { return Cell::kEmpty; }
+  if (level->wall(point.x, point.y)) { return Cell::kWall; }
+  if (level->portal(point.x, point.y)) { return Cell::kPortal; }
+  return Cell::kEmpty;
+}
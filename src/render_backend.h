@@ -0,0 +1,47 @@
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <string>
+#include "SDL.h"
+#include "level.h"
+#include "powerup.h"
+#include "snake.h"
+
+/*
+ * Draws the board, implemented per rendering backend
+ * Renderer draws to an SDL window, SoftwareRenderer rasterizes into a
+ * pixel buffer in memory for headless use.
+ */
+class RenderBackend {
+ public:
+  /*
+   * Define RenderPath type
+   * kFullRedraw redraws every cell each frame, kIncremental keeps the frame
+   * in an offscreen canvas and only repaints cells that changed
+   */
+  enum class RenderPath { kFullRedraw, kIncremental };
+
+  virtual ~RenderBackend() = default;
+
+  // Public methods
+  virtual void render(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps,
+                      RenderPath path = RenderPath::kFullRedraw) = 0;
+  virtual void render(Snake const &first, Snake const &second, SDL_Point const &food) = 0;
+  virtual void updateWindowTitle(std::string name, int score, bool withHighScore,
+                                 int highScore = 0) = 0;
+  virtual void updateWindowTitle(std::string const &title) = 0;
+  virtual void setLevel(Level const *level) = 0;
+  virtual Uint32 windowId() const = 0;  // 0 if the backend has no window
+
+ protected:
+  // Define what is drawn in a grid cell
+  enum class Cell : Uint8 { kEmpty, kFood, kBody, kHead, kSecondHead, kDeadHead, kBonus, kBoost,
+                            kShrink, kWall, kPortal };
+
+  // Shared by all backends so they draw the same picture
+  static SDL_Color cellColor(Cell cell);
+  static Cell powerUpCell(PowerUp::Type type);
+  static Cell backgroundCell(Level const *level, SDL_Point const &point);
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * SnakeRenderBench - measures offscreen frame generation
+ *
+ * Plays a scripted snake and rasterizes every tick with the software
+ * renderer, without a window or display, then reports the frame rate and
+ * writes the last frame out. With --full the whole buffer is repainted
+ * every frame, for comparison with the default dirty-cell path.
+ *
+ * Usage: SnakeRenderBench [--frames N] [--size WxH] [--grid WxH] [--level file.lvl]
+ *                         [--full] [--out frame.png|frame.ppm]
+ */
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "level.h"
+#include "powerup.h"
+#include "random.h"
+#include "snake.h"
+#include "software_renderer.h"
+
+namespace {
+
+// Parse "WxH", leaving the values untouched if it does not match
+void parseSize(std::string const &value, std::size_t &width, std::size_t &height) {
+  std::size_t x = value.find('x');
+  if (x == std::string::npos) { return; }
+  width  = std::stoul(value.substr(0, x));
+  height = std::stoul(value.substr(x + 1));
+}
+
+bool endsWith(std::string const &value, std::string const &suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t frames = 100000;
+  std::size_t screenWidth = 640;
+  std::size_t screenHeight = 640;
+  std::size_t gridWidth = 32;
+  std::size_t gridHeight = 32;
+  std::string levelPath{};
+  std::string outPath{"frame.png"};
+  bool fullRedraw = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "--full") { fullRedraw = true; continue; }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << "\n";
+      return 1;
+    }
+    std::string value{argv[++i]};
+    if (arg == "--frames")     { frames = std::stoul(value); }
+    else if (arg == "--size")  { parseSize(value, screenWidth, screenHeight); }
+    else if (arg == "--grid")  { parseSize(value, gridWidth, gridHeight); }
+    else if (arg == "--level") { levelPath = value; }
+    else if (arg == "--out")   { outPath = value; }
+    else {
+      std::cerr << "Unknown option " << arg << "\n";
+      return 1;
+    }
+  }
+
+  Level level;
+  if (!levelPath.empty()) {
+    if (!level.openFile(levelPath)) { return 1; }
+    gridWidth = static_cast<std::size_t>(level.width());
+    gridHeight = static_cast<std::size_t>(level.height());
+  }
+  if (gridWidth == 0 || gridHeight == 0 || screenWidth < gridWidth || screenHeight < gridHeight) {
+    std::cerr << "The screen needs at least one pixel per grid cell\n";
+    return 1;
+  }
+  Level const *levelPtr = level.isOpen() ? &level : nullptr;
+
+  SoftwareRenderer renderer(screenWidth, screenHeight, gridWidth, gridHeight);
+  renderer.setLevel(levelPtr);
+
+  // A fast snake moves to a new cell every tick, so every frame has work to do
+  Random script(1);
+  auto makeSnake = [&]() {
+    Snake snake(static_cast<int>(gridWidth), static_cast<int>(gridHeight));
+    snake.setLevel(levelPtr);
+    snake.speed = 1.0f;
+    if (levelPtr != nullptr && level.spawnCount() > 0) {
+      snake.headX = static_cast<float>(level.spawn(0).x);
+      snake.headY = static_cast<float>(level.spawn(0).y);
+    }
+    return snake;
+  };
+  Snake snake = makeSnake();
+  SDL_Point food{0, 0};
+  PowerUps powerUps{};
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t frame = 0; frame < frames; ++frame) {
+    if (script.next() % 6 == 0) { snake.steer(static_cast<Snake::Direction>(script.next() % 4)); }
+    if (frame % 4 == 0 && snake.body.size() < gridWidth * gridHeight / 4) { snake.growBody(); }
+    if (frame % 50 == 0) {
+      food.x = script.uniform(0, static_cast<int>(gridWidth) - 1);
+      food.y = script.uniform(0, static_cast<int>(gridHeight) - 1);
+    }
+    snake.update();
+    if (!snake.alive) { snake = makeSnake(); }
+
+    if (fullRedraw) { renderer.setLevel(levelPtr); }  // Invalidates the whole buffer
+    renderer.render(snake, food, powerUps);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  double perSecond = seconds > 0.0 ? frames / seconds : 0.0;
+  std::cout << frames << " frames of " << screenWidth << "x" << screenHeight << " ("
+            << gridWidth << "x" << gridHeight << " grid, "
+            << (fullRedraw ? "full redraw" : "dirty cells") << ") in " << std::fixed
+            << std::setprecision(3) << seconds << " s: " << std::setprecision(0) << perSecond
+            << " frames/s, " << std::setprecision(2) << perSecond / 60.0 << "x a 60 Hz display\n";
+
+  if (!outPath.empty()) {
+    SoftwareRenderer::ImageFormat format = endsWith(outPath, ".ppm") ? SoftwareRenderer::ImageFormat::kPpm
+                                                                     : SoftwareRenderer::ImageFormat::kPng;
+    if (!renderer.writeFrame(outPath, format)) { return 1; }
+    std::cout << "Last frame written to " << outPath << "\n";
+  }
+  return 0;
+}
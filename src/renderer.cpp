@@ -5,27 +5,19 @@
 Renderer::Renderer(const std::size_t screenWidth,
                    const std::size_t screenHeight,
                    const std::size_t gridWidth, 
-                   const std::size_t gridHeight)
+                   const std::size_t gridHeight,
+                   int display)
     : _screenWidth(screenWidth),
       _screenHeight(screenHeight),
       _gridWidth(gridWidth),
       _gridHeight(gridHeight)  {
 
-  // Initialize SDL
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-    std::cerr << "SDL could not initialize.\n";
-    std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
-  }
-
-  // Initialize SDL Mixer
-  if (Mix_OpenAudio( 44100, MIX_DEFAULT_FORMAT, 2, 2048 ) < 0) {
-    std::cerr << "SDL_mixer could not initialize.\n";
-    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
-  }
+  // SDL itself is initialized by the SdlContext owned by the caller
+  _viewport = SDL_Rect{0, 0, static_cast<int>(screenWidth), static_cast<int>(screenHeight)};
 
-  // Create Window
-  _sdlWindowPtr = SDL_CreateWindow("Snake Game", SDL_WINDOWPOS_CENTERED,
-                                   SDL_WINDOWPOS_CENTERED, _screenWidth,
+  // Create Window, centered on the given display
+  _sdlWindowPtr = SDL_CreateWindow("Snake Game", SDL_WINDOWPOS_CENTERED_DISPLAY(display),
+                                   SDL_WINDOWPOS_CENTERED_DISPLAY(display), _screenWidth,
                                    _screenHeight, SDL_WINDOW_SHOWN);
 
   if (nullptr == _sdlWindowPtr) {
@@ -39,91 +31,134 @@ Renderer::Renderer(const std::size_t screenWidth,
     std::cerr << "Renderer could not be created.\n";
     std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
   }
-
-  // Load bite sound effect
-  _biteSoundPtr = Mix_LoadWAV(kBiteSoundPath.c_str());
-  if (nullptr == _biteSoundPtr) {
-    std::cerr << "Failed to load biting sound effect.\n";
-    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
-  }
-
-  // Load dead snake sound effect
-  _deadSoundPtr = Mix_LoadWAV(kDeadSoundPath.c_str());
-  if (nullptr == _deadSoundPtr) {
-    std::cerr << "Failed to load dead snake sound effect.\n";
-    std::cerr << "SDL_mixer Error: " << Mix_GetError() << "\n";
-  }
 }
 
+/*
+ * Draw into a viewport of a window owned by someone else, e.g. one board
+ * of a split screen. The owner presents the window once all boards are drawn.
+ */
+Renderer::Renderer(SDL_Window *window, SDL_Renderer *renderer, SDL_Rect const &viewport,
+                   const std::size_t gridWidth, const std::size_t gridHeight)
+    : _sdlWindowPtr(window),
+      _sdlRendererPtr(renderer),
+      _viewport(viewport),
+      _ownsWindow(false),
+      _screenWidth(static_cast<std::size_t>(viewport.w)),
+      _screenHeight(static_cast<std::size_t>(viewport.h)),
+      _gridWidth(gridWidth),
+      _gridHeight(gridHeight) {}
+
 Renderer::~Renderer() {
-  Mix_FreeChunk(_deadSoundPtr);
-  Mix_FreeChunk(_biteSoundPtr);
-  SDL_DestroyRenderer(_sdlRendererPtr);
-  SDL_DestroyWindow(_sdlWindowPtr);
-  Mix_Quit();
-  SDL_Quit();
+  release_();
 }
 
 // Move Constructor
 Renderer::Renderer(Renderer &&source) {
   _sdlWindowPtr   = source._sdlWindowPtr;
   _sdlRendererPtr = source._sdlRendererPtr;
-  _biteSoundPtr   = source._biteSoundPtr;
-  _deadSoundPtr   = source._deadSoundPtr;
+  _canvasPtr      = source._canvasPtr;
+  _canvasValid    = source._canvasValid;
+  _levelPtr       = source._levelPtr;
+  _levelValid     = source._levelValid;
+  _level          = source._level;
+  _viewport       = source._viewport;
+  _ownsWindow     = source._ownsWindow;
+  _canvasCells    = std::move(source._canvasCells);
+  _frameCells     = std::move(source._frameCells);
+  _paintedCells   = std::move(source._paintedCells);
+  _visibleCells   = std::move(source._visibleCells);
   _screenWidth    = source._screenWidth;
   _screenHeight   = source._screenHeight;
   _gridWidth      = source._gridWidth;
   _gridHeight     = source._gridHeight;
-  soundEffect     = source.soundEffect;
 
   // Invalidating source after move operation
   source._sdlWindowPtr   = nullptr;
   source._sdlRendererPtr = nullptr;
-  source._biteSoundPtr   = nullptr;
-  source._deadSoundPtr   = nullptr;
+  source._canvasPtr      = nullptr;
+  source._canvasValid    = false;
+  source._levelPtr       = nullptr;
+  source._levelValid     = false;
+  source._level          = nullptr;
+  source._ownsWindow     = false;
   source._screenWidth    = 0;
   source._screenHeight   = 0;
   source._gridWidth      = 0;
   source._gridHeight     = 0;
-  source.soundEffect     = SoundEffect::kNoSound;
 }
 
 // Move Assignment Operator
 Renderer &Renderer::operator=(Renderer &&source) {
   if (this == &source) { return *this; }  // To handle self assignment scenario
 
+  release_();  // Free our own canvas, and window if we own it, before taking the source's
+
   _sdlWindowPtr   = source._sdlWindowPtr;
   _sdlRendererPtr = source._sdlRendererPtr;
-  _biteSoundPtr   = source._biteSoundPtr;
-  _deadSoundPtr   = source._deadSoundPtr;
+  _canvasPtr      = source._canvasPtr;
+  _canvasValid    = source._canvasValid;
+  _levelPtr       = source._levelPtr;
+  _levelValid     = source._levelValid;
+  _level          = source._level;
+  _viewport       = source._viewport;
+  _ownsWindow     = source._ownsWindow;
+  _canvasCells    = std::move(source._canvasCells);
+  _frameCells     = std::move(source._frameCells);
+  _paintedCells   = std::move(source._paintedCells);
+  _visibleCells   = std::move(source._visibleCells);
   _screenWidth    = source._screenWidth;
   _screenHeight   = source._screenHeight;
   _gridWidth      = source._gridWidth;
   _gridHeight     = source._gridHeight;
-  soundEffect     = source.soundEffect;
 
   // Invalidating source after move operation
   source._sdlWindowPtr   = nullptr;
   source._sdlRendererPtr = nullptr;
-  source._biteSoundPtr   = nullptr;
-  source._deadSoundPtr   = nullptr;
+  source._canvasPtr      = nullptr;
+  source._canvasValid    = false;
+  source._levelPtr       = nullptr;
+  source._levelValid     = false;
+  source._level          = nullptr;
+  source._ownsWindow     = false;
   source._screenWidth    = 0;
   source._screenHeight   = 0;
   source._gridWidth      = 0;
   source._gridHeight     = 0;
-  source.soundEffect     = SoundEffect::kNoSound;
 
   return *this;
 }
 
-void Renderer::render(Snake const &snake, SDL_Point const &food) {
+// Destroy the canvas, and the window and its renderer unless they belong to someone else
+void Renderer::release_() {
+  if (nullptr != _canvasPtr) { SDL_DestroyTexture(_canvasPtr); }
+  if (nullptr != _levelPtr) { SDL_DestroyTexture(_levelPtr); }
+  if (_ownsWindow) {
+    if (nullptr != _sdlRendererPtr) { SDL_DestroyRenderer(_sdlRendererPtr); }
+    if (nullptr != _sdlWindowPtr) { SDL_DestroyWindow(_sdlWindowPtr); }
+  }
+  _canvasPtr      = nullptr;
+  _levelPtr       = nullptr;
+  _sdlRendererPtr = nullptr;
+  _sdlWindowPtr   = nullptr;
+}
+
+void Renderer::render(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps,
+                      RenderPath path) {
+  if (path == RenderPath::kIncremental && prepareCanvas_()) {
+    renderIncremental_(snake, food, powerUps);
+  } else {
+    _canvasValid = false;  // The canvas is not kept up to date by the full path
+    renderFull_(snake, food, powerUps);
+  }
+}
+
+void Renderer::renderFull_(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps) {
   SDL_Rect block;
   block.w = _screenWidth / _gridWidth;
   block.h = _screenHeight / _gridHeight;
 
-  // Clear screen
-  SDL_SetRenderDrawColor(_sdlRendererPtr, 0x1E, 0x1E, 0x1E, 0xFF);
-  SDL_RenderClear(_sdlRendererPtr);
+  beginFrame_();
+  drawBackground_();
 
   // Render food
   SDL_SetRenderDrawColor(_sdlRendererPtr, 0xFF, 0xCC, 0x00, 0xFF);  // yellow
@@ -131,6 +166,45 @@ void Renderer::render(Snake const &snake, SDL_Point const &food) {
   block.y = food.y * block.h;
   SDL_RenderFillRect(_sdlRendererPtr, &block);
 
+  // Render power-ups
+  for (PowerUp const &powerUp : powerUps) {
+    if (powerUp.active) { fillCell_(powerUp.position, powerUpCell(powerUp.type)); }
+  }
+
+  drawSnake_(snake, Cell::kHead);
+
+  endFrame_();
+}
+
+/*
+ * Render a head-to-head match
+ * The second player's head is green to tell the snakes apart.
+ */
+void Renderer::render(Snake const &first, Snake const &second, SDL_Point const &food) {
+  _canvasValid = false;  // The canvas is not kept up to date by this path
+  beginFrame_();
+
+  // Render food
+  SDL_Rect block;
+  block.w = _screenWidth / _gridWidth;
+  block.h = _screenHeight / _gridHeight;
+  block.x = food.x * block.w;
+  block.y = food.y * block.h;
+  SDL_SetRenderDrawColor(_sdlRendererPtr, 0xFF, 0xCC, 0x00, 0xFF);  // yellow
+  SDL_RenderFillRect(_sdlRendererPtr, &block);
+
+  drawSnake_(first, Cell::kHead);
+  drawSnake_(second, Cell::kSecondHead);
+
+  endFrame_();
+}
+
+// Draw a snake's body and head, the head turns red once the snake is dead
+void Renderer::drawSnake_(Snake const &snake, Cell headCell) {
+  SDL_Rect block;
+  block.w = _screenWidth / _gridWidth;
+  block.h = _screenHeight / _gridHeight;
+
   // Render snake's body
   SDL_SetRenderDrawColor(_sdlRendererPtr, 0xFF, 0xFF, 0xFF, 0xFF);  // white
   for (SDL_Point const &point : snake.body) {
@@ -142,18 +216,174 @@ void Renderer::render(Snake const &snake, SDL_Point const &food) {
   // Render snake's head
   block.x = static_cast<int>(snake.headX) * block.w;
   block.y = static_cast<int>(snake.headY) * block.h;
-  if (snake.alive) {
-    SDL_SetRenderDrawColor(_sdlRendererPtr, 0x00, 0x7A, 0xCC, 0xFF);  // blue
-  } else {
-    SDL_SetRenderDrawColor(_sdlRendererPtr, 0xFF, 0x00, 0x00, 0xFF);  // red
+  SDL_Color headColor = cellColor(snake.alive ? headCell : Cell::kDeadHead);
+  SDL_SetRenderDrawColor(_sdlRendererPtr, headColor.r, headColor.g, headColor.b, headColor.a);
+  SDL_RenderFillRect(_sdlRendererPtr, &block);
+}
+
+/*
+ * Repaint only the cells whose content differs from the canvas
+ * Cost is proportional to the snake length, not to the grid size.
+ */
+void Renderer::renderIncremental_(Snake const &snake, SDL_Point const &food,
+                                  PowerUps const &powerUps) {
+  SDL_SetRenderTarget(_sdlRendererPtr, _canvasPtr);
+
+  // Collect what this frame shows, later entries win on shared cells
+  _visibleCells.clear();
+  auto show = [this](SDL_Point const &point, Cell cell) {
+    _frameCells[point.y * _gridWidth + point.x] = cell;
+    _visibleCells.push_back(point);
+  };
+  show(food, Cell::kFood);
+  for (PowerUp const &powerUp : powerUps) {
+    if (powerUp.active) { show(powerUp.position, powerUpCell(powerUp.type)); }
+  }
+  for (SDL_Point const &point : snake.body) {
+    show(point, Cell::kBody);
+  }
+  show(SDL_Point{static_cast<int>(snake.headX), static_cast<int>(snake.headY)},
+       snake.alive ? Cell::kHead : Cell::kDeadHead);
+
+  // Erase cells that were painted last frame and are empty now, walls and portals stay
+  for (SDL_Point const &point : _paintedCells) {
+    std::size_t index = point.y * _gridWidth + point.x;
+    Cell background = backgroundCell(_level, point);
+    if (_frameCells[index] == Cell::kEmpty && _canvasCells[index] != background) {
+      fillCell_(point, background);
+      _canvasCells[index] = background;
+    }
+  }
+
+  // Paint cells whose content changed
+  for (SDL_Point const &point : _visibleCells) {
+    std::size_t index = point.y * _gridWidth + point.x;
+    if (_canvasCells[index] != _frameCells[index]) {
+      fillCell_(point, _frameCells[index]);
+      _canvasCells[index] = _frameCells[index];
+    }
   }
+
+  // Reset the scratch grid, the visible cells are what the canvas now holds
+  for (SDL_Point const &point : _visibleCells) {
+    _frameCells[point.y * _gridWidth + point.x] = Cell::kEmpty;
+  }
+  std::swap(_paintedCells, _visibleCells);
+
+  // Copy the canvas into the viewport, switching targets reset it
+  SDL_SetRenderTarget(_sdlRendererPtr, nullptr);
+  SDL_RenderSetViewport(_sdlRendererPtr, &_viewport);
+  SDL_RenderCopy(_sdlRendererPtr, _canvasPtr, nullptr, nullptr);
+  endFrame_();
+}
+
+/*
+ * Create the canvas on first use and clear it whenever it went stale
+ * Returns false if the driver can not render to textures.
+ */
+bool Renderer::prepareCanvas_() {
+  if (nullptr == _canvasPtr) {
+    _canvasPtr = SDL_CreateTexture(_sdlRendererPtr, SDL_PIXELFORMAT_RGBA8888,
+                                   SDL_TEXTUREACCESS_TARGET, _screenWidth, _screenHeight);
+    if (nullptr == _canvasPtr) { return false; }
+  }
+  if (!_canvasValid) {
+    SDL_SetRenderTarget(_sdlRendererPtr, _canvasPtr);
+    SDL_SetRenderDrawColor(_sdlRendererPtr, 0x1E, 0x1E, 0x1E, 0xFF);
+    SDL_RenderClear(_sdlRendererPtr);
+    drawBackground_();
+    SDL_SetRenderTarget(_sdlRendererPtr, nullptr);
+
+    // Cells start out as kEmpty even under a wall or portal, erasing a cell repaints its background
+    _canvasCells.assign(_gridWidth * _gridHeight, Cell::kEmpty);
+    _frameCells.assign(_gridWidth * _gridHeight, Cell::kEmpty);
+    _paintedCells.clear();
+    _canvasValid = true;
+  }
+  return true;
+}
+
+void Renderer::fillCell_(SDL_Point const &point, Cell cell) {
+  SDL_Color color = cellColor(cell);
+  SDL_SetRenderDrawColor(_sdlRendererPtr, color.r, color.g, color.b, color.a);
+  SDL_Rect block;
+  block.w = _screenWidth / _gridWidth;
+  block.h = _screenHeight / _gridHeight;
+  block.x = point.x * block.w;
+  block.y = point.y * block.h;
   SDL_RenderFillRect(_sdlRendererPtr, &block);
+}
+
+/*
+ * Draw the level's walls and portals to the current render target
+ * The level is static, so this runs once per level into _levelPtr, and
+ * only every frame if the driver can not render to textures.
+ */
+void Renderer::drawLevel_() {
+  for (int y = 0; y < static_cast<int>(_gridHeight); ++y) {
+    for (int x = 0; x < static_cast<int>(_gridWidth); ++x) {
+      SDL_Point point{x, y};
+      Cell cell = backgroundCell(_level, point);
+      if (cell != Cell::kEmpty) { fillCell_(point, cell); }
+    }
+  }
+}
+
+/*
+ * Draw the level onto the current render target, a single texture copy
+ * The cached texture is built on first use after a level change.
+ */
+void Renderer::drawBackground_() {
+  if (nullptr == _level) { return; }
+
+  if (!_levelValid) {
+    SDL_Texture *target = SDL_GetRenderTarget(_sdlRendererPtr);
+    if (nullptr == _levelPtr) {
+      _levelPtr = SDL_CreateTexture(_sdlRendererPtr, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, _screenWidth, _screenHeight);
+    }
+    if (nullptr == _levelPtr) {
+      drawLevel_();
+      return;
+    }
+    SDL_SetRenderTarget(_sdlRendererPtr, _levelPtr);
+    SDL_SetRenderDrawColor(_sdlRendererPtr, 0x1E, 0x1E, 0x1E, 0xFF);
+    SDL_RenderClear(_sdlRendererPtr);
+    drawLevel_();
+    SDL_SetRenderTarget(_sdlRendererPtr, target);
+    if (nullptr == target) { SDL_RenderSetViewport(_sdlRendererPtr, &_viewport); }  // Reset by the switch
+    _levelValid = true;
+  }
+  SDL_RenderCopy(_sdlRendererPtr, _levelPtr, nullptr, nullptr);
+}
+
+// Draw the level's walls and portals, the grid must match the level size
+void Renderer::setLevel(Level const *level) {
+  _level = level;
+  _levelValid = false;
+  _canvasValid = false;
+}
+
+// Clear the viewport, drawing coordinates are relative to it from here on
+void Renderer::beginFrame_() {
+  SDL_RenderSetViewport(_sdlRendererPtr, &_viewport);
+  SDL_SetRenderDrawColor(_sdlRendererPtr, 0x1E, 0x1E, 0x1E, 0xFF);
+  SDL_Rect area{0, 0, _viewport.w, _viewport.h};
+  SDL_RenderFillRect(_sdlRendererPtr, &area);
+}
+
+// Update Screen, unless the window is shared and presented by its owner
+void Renderer::endFrame_() {
+  if (_ownsWindow) { SDL_RenderPresent(_sdlRendererPtr); }
+}
 
-  // Update Screen
-  SDL_RenderPresent(_sdlRendererPtr);
+// Identifies the window in SDL events, to route input to this board
+Uint32 Renderer::windowId() const {
+  return SDL_GetWindowID(_sdlWindowPtr);
 }
 
 void Renderer::updateWindowTitle(std::string name, int score, bool withHighScore, int highScore) {
+  if (!_ownsWindow) { return; }  // A shared window's title is set by its owner
   std::string title{};
   if (withHighScore) {
     title = std::string{"Player: " + name + "   " + " Score: " + std::to_string(score) + "   " + "Highest Score: " + std::to_string(highScore)};
@@ -163,16 +393,7 @@ void Renderer::updateWindowTitle(std::string name, int score, bool withHighScore
   SDL_SetWindowTitle(_sdlWindowPtr, title.c_str());
 }
 
-void Renderer::play(SoundEffect sound) {
-  switch (sound) {
-    case SoundEffect::kbiteSound:
-       Mix_PlayChannel(-1, _biteSoundPtr, 0);
-       break;
-    case SoundEffect::kdeadSnakeSound:
-       Mix_PlayChannel(-1, _deadSoundPtr, 0);
-       break;
-    default:
-       // Play no sound
-       break;
-  }
+void Renderer::updateWindowTitle(std::string const &title) {
+  if (!_ownsWindow) { return; }
+  SDL_SetWindowTitle(_sdlWindowPtr, title.c_str());
 }
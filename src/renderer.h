@@ -4,20 +4,22 @@
 #include <vector>
 #include <string>
 #include "SDL.h"
-#include "SDL_mixer.h"
+#include "level.h"
+#include "powerup.h"
+#include "render_backend.h"
 #include "snake.h"
 
-class Renderer {
+// Draws the board to an SDL window
+class Renderer : public RenderBackend {
  public:
-  // Define SoundEffect Type
-  enum class SoundEffect { kbiteSound, kdeadSnakeSound, kNoSound };
-
-  // Constructor
+  // Constructors
   Renderer(const std::size_t screenWidth, const std::size_t screenHeight,
+           const std::size_t gridWidth, const std::size_t gridHeight, int display = 0);
+  Renderer(SDL_Window *window, SDL_Renderer *renderer, SDL_Rect const &viewport,
            const std::size_t gridWidth, const std::size_t gridHeight);
 
   // Destructor
-  ~Renderer();
+  ~Renderer() override;
 
   /*
    * Rule of 5 implementation
@@ -33,20 +35,42 @@ class Renderer {
   Renderer &operator=(Renderer &&source);
 
   // Public methods
-  void render(Snake const &snake, SDL_Point const &food);
-  void updateWindowTitle(std::string name, int score, bool withHighScore, int highScore = 0);
-  void play(SoundEffect sound);
-
-  // Public data
-  const std::string kBiteSoundPath{"../assets/biting-sound.wav"};
-  const std::string kDeadSoundPath{"../assets/dead.wav"};
-  SoundEffect soundEffect{SoundEffect::kNoSound};
+  void render(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps,
+              RenderPath path = RenderPath::kFullRedraw) override;
+  void render(Snake const &first, Snake const &second, SDL_Point const &food) override;
+  void updateWindowTitle(std::string name, int score, bool withHighScore,
+                         int highScore = 0) override;
+  void updateWindowTitle(std::string const &title) override;
+  void setLevel(Level const *level) override;
+  Uint32 windowId() const override;
 
  private:
+  // Private methods
+  void renderFull_(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps);
+  void renderIncremental_(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps);
+  void drawSnake_(Snake const &snake, Cell headCell);
+  bool prepareCanvas_();
+  void fillCell_(SDL_Point const &point, Cell cell);
+  void drawLevel_();
+  void drawBackground_();
+  void beginFrame_();
+  void endFrame_();
+  void release_();
+
   SDL_Window   *_sdlWindowPtr;
   SDL_Renderer *_sdlRendererPtr;
-  Mix_Chunk    *_biteSoundPtr;   // To store biting sound effect
-  Mix_Chunk    *_deadSoundPtr;   // To store dead snake sound effect
+  SDL_Texture  *_canvasPtr{nullptr};  // Persistent frame for the incremental path
+  SDL_Texture  *_levelPtr{nullptr};   // Background with the level's walls and portals
+  bool          _levelValid{false};   // Whether _levelPtr shows the current level
+  Level const  *_level{nullptr};      // Walls and portals, none on the open board
+  SDL_Rect      _viewport{};          // Area of the window this renderer draws to
+  bool          _ownsWindow{true};    // False for a board of a shared window
+  bool          _canvasValid{false};  // Whether _canvasCells matches the canvas content
+
+  std::vector<Cell>      _canvasCells{};   // What is currently painted on the canvas, per cell
+  std::vector<Cell>      _frameCells{};    // Scratch: what the current frame wants, per cell
+  std::vector<SDL_Point> _paintedCells{};  // Non-empty cells on the canvas
+  std::vector<SDL_Point> _visibleCells{};  // Scratch: non-empty cells of the current frame
 
   std::size_t _screenWidth;
   std::size_t _screenHeight;
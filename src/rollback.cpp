@@ -0,0 +1,133 @@
+#include "rollback.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+constexpr std::uint32_t kNoRollback{std::numeric_limits<std::uint32_t>::max()};
+}  // namespace
+
+RollbackSession::RollbackSession(std::size_t gridWidth, std::size_t gridHeight,
+                                 std::uint64_t seed, int localPlayer)
+    : _simulation(gridWidth, gridHeight, seed),
+      _localPlayer(localPlayer),
+      _rollbackFrom(kNoRollback),
+      _states(kHistory),
+      _localInputs(kHistory, kNoInput),
+      _remoteInputs(kHistory, kNoInput),
+      _remoteTicks(kHistory, kNoRollback),
+      _remoteKnown(kHistory, false) {
+  // Nothing can be pressed during the input delay of the first ticks
+  _localEnd = kInputDelay;
+}
+
+/*
+ * Schedule the local input for the next free tick, kInputDelay ticks
+ * after the current one. Returns false if that tick already has an
+ * input, i.e. the session is stalled waiting for the remote player.
+ */
+bool RollbackSession::addLocalInput(PlayerInput input) {
+  if (_localEnd > _tick + kInputDelay) { return false; }
+  _localInputs[_localEnd % kHistory] = input;
+  ++_localEnd;
+  return true;
+}
+
+/*
+ * Record an input received from the remote player
+ * Duplicates (packets carry redundant inputs) are ignored. An input for a
+ * tick that was already simulated with a different prediction schedules a
+ * rollback, carried out by the next synchronize() or advance().
+ */
+void RollbackSession::addRemoteInput(std::uint32_t tick, PlayerInput input) {
+  if (tick < _remoteEnd || tick >= _tick + kHistory - kMaxRollback) { return; }
+
+  std::size_t slot = tick % kHistory;
+  if (_remoteTicks[slot] == tick && _remoteKnown[slot]) { return; }
+
+  _remoteTicks[slot]  = tick;
+  _remoteInputs[slot] = input;
+  _remoteKnown[slot]  = true;
+
+  // Unknown remote inputs were simulated as kNoInput
+  if (tick < _tick && input != kNoInput) {
+    _rollbackFrom = std::min(_rollbackFrom, tick);
+  }
+
+  while (_remoteTicks[_remoteEnd % kHistory] == _remoteEnd && _remoteKnown[_remoteEnd % kHistory]) {
+    ++_remoteEnd;
+  }
+}
+
+/*
+ * Simulate the next tick with the best known inputs
+ * Returns false without simulating if the local input for the tick is
+ * missing or the session would get too far ahead of the remote player.
+ */
+bool RollbackSession::advance() {
+  synchronize();
+  if (_failed) { return false; }
+
+  if (_tick >= _localEnd || _tick >= _remoteEnd + kMaxRollback) {
+    ++_stats.stalls;
+    return false;
+  }
+
+  if (!_simulation.save(_states[_tick % kHistory])) {
+    _failed = true;
+    return false;
+  }
+  _simulation.step(inputs_(_tick));
+  ++_tick;
+  ++_stats.ticks;
+  return true;
+}
+
+// Carry out a pending rollback: restore the mispredicted tick and re-simulate
+void RollbackSession::synchronize() {
+  if (_rollbackFrom == kNoRollback || _failed) { return; }
+
+  auto start = std::chrono::steady_clock::now();
+  std::uint32_t depth = _tick - _rollbackFrom;
+
+  _simulation.restore(_states[_rollbackFrom % kHistory]);
+  for (std::uint32_t tick = _rollbackFrom; tick < _tick; ++tick) {
+    if (!_simulation.save(_states[tick % kHistory])) {
+      _failed = true;
+      return;
+    }
+    _simulation.step(inputs_(tick));
+  }
+  _rollbackFrom = kNoRollback;
+
+  double elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+  ++_stats.rollbacks;
+  _stats.resimulatedTicks += depth;
+  _stats.maxRollbackTicks = std::max<std::uint64_t>(_stats.maxRollbackTicks, depth);
+  _stats.resimulationMs += elapsed;
+  _stats.maxResimulationMs = std::max(_stats.maxResimulationMs, elapsed);
+}
+
+// Inputs of both players for a tick, predicting "no input" for unknown remote input
+std::array<PlayerInput, kVersusPlayers> RollbackSession::inputs_(std::uint32_t tick) const {
+  std::size_t slot = tick % kHistory;
+  std::array<PlayerInput, kVersusPlayers> inputs{};
+  inputs[_localPlayer] = _localInputs[slot];
+  bool known = _remoteTicks[slot] == tick && _remoteKnown[slot];
+  inputs[1 - _localPlayer] = known ? _remoteInputs[slot] : kNoInput;
+  return inputs;
+}
+
+// Getters definition
+int RollbackSession::localPlayer() const                   { return _localPlayer; }
+bool RollbackSession::failed() const                       { return _failed;      }
+std::uint32_t RollbackSession::currentTick() const         { return _tick;        }
+std::uint32_t RollbackSession::localInputEnd() const       { return _localEnd;    }
+std::uint32_t RollbackSession::remoteInputEnd() const      { return _remoteEnd;   }
+VersusSimulation const &RollbackSession::simulation() const { return _simulation; }
+RollbackStats const &RollbackSession::stats() const        { return _stats;       }
+
+PlayerInput RollbackSession::localInput(std::uint32_t tick) const {
+  return _localInputs[tick % kHistory];
+}
@@ -0,0 +1,82 @@
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "input.h"
+#include "versus.h"
+
+// Counters describing how much rollback work a session did
+struct RollbackStats {
+  std::uint64_t ticks{0};              // Ticks simulated for the first time
+  std::uint64_t rollbacks{0};          // Mispredictions that forced a re-simulation
+  std::uint64_t resimulatedTicks{0};   // Ticks simulated again because of rollbacks
+  std::uint64_t maxRollbackTicks{0};   // Deepest single rollback
+  std::uint64_t stalls{0};             // Times advance() waited for the remote player
+  double        resimulationMs{0.0};   // Time spent re-simulating
+  double        maxResimulationMs{0.0};
+};
+
+/*
+ * Rollback netcode for a head-to-head match, independent of any transport
+ *
+ * Local inputs are scheduled kInputDelay ticks ahead. The remote player's
+ * input is predicted as "no input" until it arrives; when a late input
+ * differs from the prediction, the simulation is restored to the snapshot
+ * taken at that tick and re-simulated up to the present. The session
+ * stalls rather than run more than kMaxRollback ticks ahead of the last
+ * confirmed remote input. If a state no longer fits its snapshot layout
+ * the session fails: rolling back onto a stale snapshot would silently
+ * desync the peers, so it stops simulating instead.
+ */
+class RollbackSession {
+ public:
+  // Constructor
+  RollbackSession(std::size_t gridWidth, std::size_t gridHeight,
+                  std::uint64_t seed, int localPlayer);
+
+  // Public methods
+  bool addLocalInput(PlayerInput input);
+  void addRemoteInput(std::uint32_t tick, PlayerInput input);
+  bool advance();
+  void synchronize();
+
+  // Getters
+  int localPlayer() const;
+  bool failed() const;
+  std::uint32_t currentTick() const;
+  std::uint32_t localInputEnd() const;
+  std::uint32_t remoteInputEnd() const;
+  PlayerInput localInput(std::uint32_t tick) const;
+  VersusSimulation const &simulation() const;
+  RollbackStats const &stats() const;
+
+  // Public data
+  static constexpr std::uint32_t kInputDelay{2};
+  static constexpr std::uint32_t kMaxRollback{30};
+  static constexpr std::uint32_t kHistory{128};  // Must exceed 2 * (kMaxRollback + kInputDelay)
+
+ private:
+  // Private methods
+  std::array<PlayerInput, kVersusPlayers> inputs_(std::uint32_t tick) const;
+
+  // Private data
+  VersusSimulation _simulation;
+  int              _localPlayer;
+  std::uint32_t    _tick{0};            // Next tick to simulate
+  std::uint32_t    _localEnd{0};        // Local inputs are known for ticks before this
+  std::uint32_t    _remoteEnd{0};       // Remote inputs are known for all ticks before this
+  std::uint32_t    _rollbackFrom;       // Earliest mispredicted tick, or kNoRollback
+  bool             _failed{false};      // A snapshot could not be saved, the match is over
+  RollbackStats    _stats{};
+
+  // Rings indexed by tick % kHistory
+  std::vector<VersusState>   _states;         // State at the start of each tick
+  std::vector<PlayerInput>   _localInputs;
+  std::vector<PlayerInput>   _remoteInputs;
+  std::vector<std::uint32_t> _remoteTicks;    // Tick each remote slot holds, to spot stale slots
+  std::vector<bool>          _remoteKnown;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "sdl_context.h"
+#include <iostream>
+
+SdlContext::SdlContext(Uint32 subsystems) {
+  if (SDL_Init(subsystems) < 0) {
+    std::cerr << "SDL could not initialize.\n";
+    std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+    return;
+  }
+  _initialized = true;
+}
+
+SdlContext::~SdlContext() {
+  if (_initialized) { SDL_Quit(); }
+}
+
+bool SdlContext::ok() const {
+  return _initialized;
+}
@@ -0,0 +1,32 @@
+#ifndef SDL_CONTEXT_H
+#define SDL_CONTEXT_H
+
+#include "SDL.h"
+
+/*
+ * Owns the SDL library lifetime for the whole process
+ * Create exactly one before any window, renderer or audio device and keep
+ * it alive until all of them are gone. Windows and renderers only create
+ * and destroy their own resources, so any number of them can come and go
+ * (or be moved from) without shutting SDL down underneath the others.
+ */
+class SdlContext {
+ public:
+  // Constructor
+  explicit SdlContext(Uint32 subsystems = SDL_INIT_VIDEO);
+
+  // Destructor
+  ~SdlContext();
+
+  // Owns a process wide resource, so it can neither be copied nor moved
+  SdlContext(const SdlContext &) = delete;
+  SdlContext &operator=(const SdlContext &) = delete;
+
+  // Public methods
+  bool ok() const;
+
+ private:
+  bool _initialized{false};
+};
+
+#endif
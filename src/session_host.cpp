@@ -0,0 +1,287 @@
+#include "session_host.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "renderer.h"
+
+namespace {
+
+// Boards sharing a keyboard each steer with their own keys, from the fifth board on they repeat
+const ControlKeys kSharedKeyboardKeys[]{
+    ControlKeys{SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT},
+    ControlKeys{SDLK_w, SDLK_s, SDLK_a, SDLK_d},
+    ControlKeys{SDLK_i, SDLK_k, SDLK_j, SDLK_l},
+    ControlKeys{SDLK_KP_8, SDLK_KP_5, SDLK_KP_4, SDLK_KP_6}};
+
+// Window an event belongs to, 0 for events that concern every window
+Uint32 eventWindowId(SDL_Event const &e) {
+  switch (e.type) {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+      return e.key.windowID;
+    case SDL_WINDOWEVENT:
+      return e.window.windowID;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+SessionHost::SessionHost(Layout layout, std::size_t sessions, std::size_t screenWidth,
+                         std::size_t screenHeight, std::size_t gridWidth, std::size_t gridHeight,
+                         std::shared_ptr<AudioSystem> audio, Level const *level)
+    : _layout(layout) {
+  std::size_t columns = columns_(sessions);
+  std::size_t rows = (sessions + columns - 1) / columns;
+  SDL_Point board = boardSize(layout, sessions, screenWidth, screenHeight);
+  int boardWidth = board.x;
+  int boardHeight = board.y;
+
+  if (_layout == Layout::kSplitScreen) {
+    _sharedWindowPtr = SDL_CreateWindow("Snake Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                        boardWidth * static_cast<int>(columns),
+                                        boardHeight * static_cast<int>(rows), SDL_WINDOW_SHOWN);
+    if (nullptr == _sharedWindowPtr) {
+      std::cerr << "Window could not be created.\n";
+      std::cerr << " SDL_Error: " << SDL_GetError() << "\n";
+    }
+    _sharedRendererPtr = SDL_CreateRenderer(_sharedWindowPtr, -1, SDL_RENDERER_ACCELERATED);
+    if (nullptr == _sharedRendererPtr) {
+      std::cerr << "Renderer could not be created.\n";
+      std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+    }
+  }
+
+  int displays = std::max(SDL_GetNumVideoDisplays(), 1);
+  for (std::size_t i = 0; i < sessions; ++i) {
+    std::unique_ptr<Game> game;
+    if (_layout == Layout::kSplitScreen) {
+      SDL_Rect viewport{static_cast<int>(i % columns) * boardWidth,
+                        static_cast<int>(i / columns) * boardHeight, boardWidth, boardHeight};
+      game = std::make_unique<Game>(
+          gridWidth, gridHeight, Controller(kSharedKeyboardKeys[i % 4]),
+          std::make_unique<Renderer>(_sharedWindowPtr, _sharedRendererPtr, viewport, gridWidth,
+                                     gridHeight),
+          audio);
+    } else {
+      game = std::make_unique<Game>(
+          gridWidth, gridHeight, Controller(),
+          std::make_unique<Renderer>(screenWidth, screenHeight, gridWidth, gridHeight,
+                                     static_cast<int>(i) % displays),
+          audio);
+    }
+    if (nullptr != level) { game->setLevel(*level); }
+    game->startHosted("Player " + std::to_string(i + 1));
+    _sessions.push_back(std::move(game));
+  }
+}
+
+// Practice mode for every session, each one rewinds its own board with 'r'
+void SessionHost::setPracticeMode(bool enabled) {
+  for (auto &session : _sessions) {
+    session->setPracticeMode(enabled);
+  }
+}
+
+// Size in pixels of each session's board
+SDL_Point SessionHost::boardSize(Layout layout, std::size_t sessions, std::size_t screenWidth,
+                                 std::size_t screenHeight) {
+  if (layout == Layout::kWindows || sessions <= 1) {
+    return SDL_Point{static_cast<int>(screenWidth), static_cast<int>(screenHeight)};
+  }
+  std::size_t columns = columns_(sessions);
+  std::size_t rows = (sessions + columns - 1) / columns;
+  return SDL_Point{static_cast<int>(screenWidth / columns), static_cast<int>(screenHeight / rows)};
+}
+
+// Split screen boards form a near-square grid
+std::size_t SessionHost::columns_(std::size_t sessions) {
+  return static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(sessions))));
+}
+
+// Sessions draw into the shared window, so they go first
+SessionHost::~SessionHost() {
+  _sessions.clear();
+  if (nullptr != _sharedRendererPtr) { SDL_DestroyRenderer(_sharedRendererPtr); }
+  if (nullptr != _sharedWindowPtr) { SDL_DestroyWindow(_sharedWindowPtr); }
+}
+
+/*
+ * Run all sessions until every one has ended
+ * Same fixed-timestep loop as a single game: all sessions advance in
+ * lockstep, each one's governor decides how its board is rendered.
+ */
+void SessionHost::run() {
+  if (_sessions.empty()) { return; }
+
+  const double tickDuration = static_cast<double>(_sessions.front()->kTargetFrameDuration);
+  const std::size_t maxCatchUpTicks = _sessions.front()->kMaxCatchUpTicks;
+  const double countsPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+
+  Uint32 titleTimestamp = SDL_GetTicks();
+  Uint64 previous = SDL_GetPerformanceCounter();
+  double lag = 0.0;  // Simulation time owed, in ms
+
+  auto running = [this]() {
+    for (auto const &session : _sessions) {
+      if (!session->finished()) { return true; }
+    }
+    return false;
+  };
+  auto idle = [this]() {
+    for (auto const &session : _sessions) {
+      if (!session->finished() && !session->idle()) { return false; }
+    }
+    return true;
+  };
+
+  while (running()) {
+    if (idle()) {
+      // Every live board is paused or hidden: near zero CPU, sleep until an event arrives
+      SDL_Event e;
+      if (SDL_WaitEventTimeout(&e, _sessions.front()->kIdleWaitTimeout)) {
+        dispatch_(e);
+        while (SDL_PollEvent(&e)) {
+          dispatch_(e);
+        }
+      }
+      redrawExposed_();
+      previous = SDL_GetPerformanceCounter();  // Do not catch up on time spent idle
+      lag = 0.0;
+      continue;
+    }
+
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    lag += (frameStart - previous) / countsPerMs;
+    previous = frameStart;
+
+    // One event pump for every session
+    SDL_Event e;
+    while (SDL_PollEvent(&e)) {
+      dispatch_(e);
+    }
+
+    std::size_t ticks = 0;
+    while (lag >= tickDuration && ticks < maxCatchUpTicks) {
+      for (auto &session : _sessions) {
+        session->step();
+      }
+      lag -= tickDuration;
+      ++ticks;
+    }
+    if (ticks == maxCatchUpTicks) {
+      lag = 0.0;  // Too far behind, drop the backlog instead of spiralling
+    }
+
+    /*
+     * A shared window is presented as a whole, so every board has to be
+     * drawn into it each time. Separate windows render independently.
+     */
+    if (_layout == Layout::kSplitScreen) {
+      if (ticks > 0) {
+        for (auto &session : _sessions) {
+          session->present(true);
+        }
+        SDL_RenderPresent(_sharedRendererPtr);
+      }
+    } else {
+      for (auto &session : _sessions) {
+        if (session->finished()) {
+          hideWindow_(*session);
+          continue;
+        }
+        session->present();
+      }
+    }
+
+    // After every second, update the window title.
+    Uint32 frameEnd = SDL_GetTicks();
+    if (frameEnd - titleTimestamp >= 1000) {
+      updateWindowTitle_();
+      titleTimestamp = frameEnd;
+    }
+
+    double remaining = tickDuration - lag - (SDL_GetPerformanceCounter() - frameStart) / countsPerMs;
+    if (remaining >= 1.0) {
+      SDL_Delay(static_cast<Uint32>(remaining));
+    }
+  }
+
+  displayResults_();
+}
+
+/*
+ * Route an event to the sessions it concerns
+ * Boards of a split screen all see every event and react to their own
+ * keys. With separate windows, keyboard and window events go to the
+ * session of the window they happened in.
+ */
+void SessionHost::dispatch_(SDL_Event const &e) {
+  Uint32 windowId = eventWindowId(e);
+  if (_layout == Layout::kSplitScreen || windowId == 0) {
+    for (auto &session : _sessions) {
+      session->handleEvent(e);
+    }
+    return;
+  }
+
+  for (auto &session : _sessions) {
+    if (session->windowId() != windowId) { continue; }
+
+    // Closing one of several windows only ends that session
+    if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_CLOSE) {
+      SDL_Event quit{};
+      quit.type = SDL_QUIT;
+      session->handleEvent(quit);
+    } else {
+      session->handleEvent(e);
+    }
+  }
+}
+
+// Redraw boards whose window content was lost while nothing else is drawn
+void SessionHost::redrawExposed_() {
+  bool redraw = false;
+  for (auto &session : _sessions) {
+    if (!session->redrawRequested() || session->finished()) { continue; }
+    redraw = true;
+    if (_layout == Layout::kWindows) { session->present(true); }
+  }
+
+  // A shared window is presented as a whole, so every board is drawn again
+  if (redraw && _layout == Layout::kSplitScreen) {
+    for (auto &session : _sessions) {
+      session->present(true);
+    }
+    SDL_RenderPresent(_sharedRendererPtr);
+  }
+}
+
+// Take a finished session's window off the screen while the other sessions play on
+void SessionHost::hideWindow_(Game const &session) {
+  SDL_Window *window = SDL_GetWindowFromID(session.windowId());
+  if (nullptr != window && (SDL_GetWindowFlags(window) & SDL_WINDOW_SHOWN)) {
+    SDL_HideWindow(window);
+  }
+}
+
+// The boards of a shared window list their scores in its title
+void SessionHost::updateWindowTitle_() {
+  if (_layout != Layout::kSplitScreen) { return; }  // Sessions title their own windows
+
+  std::string title{};
+  for (std::size_t i = 0; i < _sessions.size(); ++i) {
+    if (i > 0) { title += "   "; }
+    title += _sessions[i]->getPlayerName() + ": " + std::to_string(_sessions[i]->getScore());
+  }
+  SDL_SetWindowTitle(_sharedWindowPtr, title.c_str());
+}
+
+void SessionHost::displayResults_() {
+  std::cout << "GAME OVER!" << "\n";
+  for (auto const &session : _sessions) {
+    std::cout << session->getPlayerName() << " score: " << session->getScore() << "\n";
+  }
+}
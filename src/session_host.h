@@ -0,0 +1,59 @@
+#ifndef SESSION_HOST_H
+#define SESSION_HOST_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "SDL.h"
+#include "audio.h"
+#include "game.h"
+#include "level.h"
+
+/*
+ * Runs several independent game sessions in one process
+ * Sessions either share one window, split into a grid of boards, or get a
+ * window each, spread over the available displays. A single event pump
+ * routes input to the sessions and a single fixed-timestep loop advances
+ * them all. SDL itself and the audio device are owned by the caller and
+ * shared by every session.
+ */
+class SessionHost {
+ public:
+  // Define Layout type
+  enum class Layout { kSplitScreen, kWindows };
+
+  // Constructor
+  SessionHost(Layout layout, std::size_t sessions, std::size_t screenWidth,
+              std::size_t screenHeight, std::size_t gridWidth, std::size_t gridHeight,
+              std::shared_ptr<AudioSystem> audio, Level const *level = nullptr);
+
+  // Destructor
+  ~SessionHost();
+
+  // Owns the shared window, so it can neither be copied nor moved
+  SessionHost(const SessionHost &) = delete;
+  SessionHost &operator=(const SessionHost &) = delete;
+
+  // Public methods
+  void run();
+  void setPracticeMode(bool enabled);
+  static SDL_Point boardSize(Layout layout, std::size_t sessions, std::size_t screenWidth,
+                             std::size_t screenHeight);
+
+ private:
+  // Private methods
+  void dispatch_(SDL_Event const &e);
+  void redrawExposed_();
+  void hideWindow_(Game const &session);
+  void updateWindowTitle_();
+  void displayResults_();
+  static std::size_t columns_(std::size_t sessions);
+
+  // Private data
+  Layout                             _layout;
+  SDL_Window                        *_sharedWindowPtr{nullptr};    // Split screen only
+  SDL_Renderer                      *_sharedRendererPtr{nullptr};
+  std::vector<std::unique_ptr<Game>> _sessions{};
+};
+
+#endif
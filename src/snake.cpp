@@ -1,6 +1,9 @@
 #include "snake.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include "level.h"
+#include "snapshot.h"
 
 void Snake::update() {
   SDL_Point previousCell{
@@ -15,6 +18,19 @@ void Snake::update() {
       static_cast<int>(headY)
   };  // Capture the head's cell after updating.
 
+  if (nullptr != _level && (currentCell.x != previousCell.x || currentCell.y != previousCell.y)) {
+    // Running into a wall is fatal, a single bitmap lookup
+    if (_level->wall(currentCell.x, currentCell.y)) {
+      alive = false;
+    } else if (_level->portal(currentCell.x, currentCell.y)) {
+      // Come out of the other end, keeping the progress within the cell
+      SDL_Point exit = _level->portalExit(currentCell.x, currentCell.y);
+      headX += exit.x - currentCell.x;
+      headY += exit.y - currentCell.y;
+      currentCell = exit;
+    }
+  }
+
   /*
    * Update all of the body vector items 
    * if the snake head has moved to a new cell.
@@ -76,12 +92,41 @@ void Snake::updateBody_(SDL_Point &&currentHeadCell, SDL_Point &&previousHeadCel
   }
 }
 
+void Snake::steer(Direction input) {
+  Direction opposite = Direction::kUp;
+  switch (input) {
+    case Direction::kUp:    opposite = Direction::kDown;  break;
+    case Direction::kDown:  opposite = Direction::kUp;    break;
+    case Direction::kLeft:  opposite = Direction::kRight; break;
+    case Direction::kRight: opposite = Direction::kLeft;  break;
+  }
+  /*
+   * Here the opposite direction is used to prevent the snake
+   * to move into itself if it's size is more than 1
+   */
+  if (direction != opposite || size == 1) {
+    direction = input;
+  }
+}
+
+// Use the level's walls and portals, nullptr for the open wraparound board
+void Snake::setLevel(Level const *level) {
+  _level = level;
+}
+
 void Snake::growBody() { 
   _growing = true; 
 }
 
+// Remove up to the given number of segments from the tail, the head always stays.
+void Snake::shrinkBody(int segments) {
+  int removed = std::min(segments, static_cast<int>(body.size()));
+  body.erase(body.begin(), body.begin() + removed);
+  size -= removed;
+}
+
 // Check if the cell is occupied by snake.
-bool Snake::snakeCell(int x, int y) {
+bool Snake::snakeCell(int x, int y) const {
   if (x == static_cast<int>(headX) && y == static_cast<int>(headY)) {
     return true;
   }
@@ -91,4 +136,33 @@ bool Snake::snakeCell(int x, int y) {
     }
   }
   return false;
-}
\ No newline at end of file
+}
+
+/*
+ * Capture the complete snake state, including the private growth flag
+ * Returns false if the body is too long for the snapshot layout.
+ */
+bool Snake::save(SnakeState &state) const {
+  if (body.size() > kMaxSnapshotBodyCells) { return false; }
+  state.direction  = direction;
+  state.speed      = speed;
+  state.size       = size;
+  state.alive      = alive;
+  state.growing    = _growing;
+  state.headX      = headX;
+  state.headY      = headY;
+  state.bodyLength = static_cast<std::uint32_t>(body.size());
+  std::copy(body.begin(), body.end(), state.body);
+  return true;
+}
+
+void Snake::restore(SnakeState const &state) {
+  direction = state.direction;
+  speed     = state.speed;
+  size      = state.size;
+  alive     = state.alive;
+  _growing  = state.growing;
+  headX     = state.headX;
+  headY     = state.headY;
+  body.assign(state.body, state.body + state.bodyLength);
+}
@@ -4,6 +4,9 @@
 #include <vector>
 #include "SDL.h"
 
+class Level;
+struct SnakeState;
+
 class Snake {
  public:
   // Define Direction type
@@ -19,7 +22,12 @@ class Snake {
   // Public Methods
   void update();
   void growBody();
-  bool snakeCell(int x, int y);
+  void shrinkBody(int segments);
+  void steer(Direction input);
+  void setLevel(Level const *level);
+  bool snakeCell(int x, int y) const;
+  bool save(SnakeState &state) const;
+  void restore(SnakeState const &state);
 
   // Public Data
   Direction direction = Direction::kUp;
@@ -39,6 +47,7 @@ class Snake {
   bool _growing{false};
   int  _gridWidth;
   int  _gridHeight;
+  Level const *_level{nullptr};  // Walls and portals, none on the open board
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "snapshot.h"
+
+SnapshotHistory::SnapshotHistory(std::size_t capacity)
+    : _slots(capacity > 0 ? capacity : 1) {}
+
+// Slot for the newest snapshot, overwriting the oldest one when full
+GameSnapshot &SnapshotHistory::record() {
+  _newest = (_newest + 1) % _slots.size();
+  if (_count < _slots.size()) { ++_count; }
+  return _slots[_newest];
+}
+
+/*
+ * Step back up to the given number of ticks and drop everything newer,
+ * so that rewinding again continues further into the past.
+ * Returns nullptr if nothing has been recorded.
+ */
+GameSnapshot const *SnapshotHistory::rewind(std::size_t ticks) {
+  if (_count == 0) { return nullptr; }
+  std::size_t steps = (ticks < _count) ? ticks : _count - 1;
+  _newest = (_newest + _slots.size() - steps) % _slots.size();
+  _count -= steps;
+  return &_slots[_newest];
+}
+
+void SnapshotHistory::clear() {
+  _count = 0;
+}
+
+std::size_t SnapshotHistory::size() const {
+  return _count;
+}
@@ -0,0 +1,69 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "SDL.h"
+#include "powerup.h"
+#include "random.h"
+#include "snake.h"
+
+// Longest snake a snapshot can hold, enough for the default 32x32 grid
+constexpr std::size_t kMaxSnapshotBodyCells{1024};
+
+// Complete state of a Snake in a fixed layout
+struct SnakeState {
+  Snake::Direction direction;
+  float            speed;
+  int              size;
+  bool             alive;
+  bool             growing;
+  float            headX;
+  float            headY;
+  std::uint32_t    bodyLength;
+  SDL_Point        body[kMaxSnapshotBodyCells];
+};
+
+/*
+ * Complete state of a single player game in a fixed layout
+ * Being trivially copyable, saving and restoring it is a plain memcpy.
+ */
+struct GameSnapshot {
+  std::uint32_t tick;
+  int           score;
+  SDL_Point     food;
+  Random        random;
+  PowerUps      powerUps;
+  std::uint32_t foodExpiresAt;   // Timed events, the timing wheel is rebuilt from these
+  std::uint32_t nextSpawnAt;
+  std::uint32_t boostEndsAt;     // 0 while no speed boost is active
+  SnakeState    snake;
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+              "GameSnapshot must stay memcpy-able");
+
+/*
+ * Fixed capacity ring of the most recent per-tick snapshots
+ * All slots are allocated up front; recording writes into the next slot
+ * in place, so the game loop never allocates.
+ */
+class SnapshotHistory {
+ public:
+  // Constructor
+  explicit SnapshotHistory(std::size_t capacity);
+
+  // Public methods
+  GameSnapshot &record();
+  GameSnapshot const *rewind(std::size_t ticks);
+  void clear();
+  std::size_t size() const;
+
+ private:
+  std::vector<GameSnapshot> _slots;
+  std::size_t               _newest{0};
+  std::size_t               _count{0};
+};
+
+#endif
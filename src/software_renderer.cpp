@@ -0,0 +1,204 @@
+#include "software_renderer.h"
+#include <algorithm>
+#include <cstdio>
+#include "image_writer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SNAKE_SIMD_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SNAKE_SIMD_NEON
+#endif
+
+namespace {
+
+// Fill count pixels with one color, four pixels per store where SIMD is available
+void fillSpan(std::uint32_t *pixels, std::size_t count, std::uint32_t color) {
+  std::size_t i = 0;
+#if defined(SNAKE_SIMD_SSE2)
+  __m128i quad = _mm_set1_epi32(static_cast<int>(color));
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), quad);
+  }
+#elif defined(SNAKE_SIMD_NEON)
+  uint32x4_t quad = vdupq_n_u32(color);
+  for (; i + 4 <= count; i += 4) {
+    vst1q_u32(pixels + i, quad);
+  }
+#endif
+  for (; i < count; ++i) {
+    pixels[i] = color;
+  }
+}
+
+}  // namespace
+
+SoftwareRenderer::SoftwareRenderer(const std::size_t screenWidth, const std::size_t screenHeight,
+                                   const std::size_t gridWidth, const std::size_t gridHeight)
+    : _pixels(screenWidth * screenHeight),
+      _screenWidth(screenWidth),
+      _screenHeight(screenHeight),
+      _gridWidth(gridWidth),
+      _gridHeight(gridHeight),
+      _cellWidth(screenWidth / gridWidth),
+      _cellHeight(screenHeight / gridHeight) {}
+
+/*
+ * The pixel buffer is never stale, so every frame takes the incremental
+ * path whatever the governor asks for
+ */
+void SoftwareRenderer::render(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps,
+                              RenderPath) {
+  show_(food, Cell::kFood);
+  for (PowerUp const &powerUp : powerUps) {
+    if (powerUp.active) { show_(powerUp.position, powerUpCell(powerUp.type)); }
+  }
+  for (SDL_Point const &point : snake.body) {
+    show_(point, Cell::kBody);
+  }
+  show_(SDL_Point{static_cast<int>(snake.headX), static_cast<int>(snake.headY)},
+        snake.alive ? Cell::kHead : Cell::kDeadHead);
+  commitFrame_();
+}
+
+// Render a head-to-head match, the second player's head is green
+void SoftwareRenderer::render(Snake const &first, Snake const &second, SDL_Point const &food) {
+  show_(food, Cell::kFood);
+  for (SDL_Point const &point : first.body) { show_(point, Cell::kBody); }
+  for (SDL_Point const &point : second.body) { show_(point, Cell::kBody); }
+  show_(SDL_Point{static_cast<int>(first.headX), static_cast<int>(first.headY)},
+        first.alive ? Cell::kHead : Cell::kDeadHead);
+  show_(SDL_Point{static_cast<int>(second.headX), static_cast<int>(second.headY)},
+        second.alive ? Cell::kSecondHead : Cell::kDeadHead);
+  commitFrame_();
+}
+
+// Draw the level's walls and portals, the grid must match the level size
+void SoftwareRenderer::setLevel(Level const *level) {
+  _level = level;
+  _valid = false;
+}
+
+Uint32 SoftwareRenderer::windowId() const {
+  return 0;
+}
+
+/*
+ * Write every interval-th rendered frame to pathPrefix followed by the
+ * six digit frame number, 0 stops recording
+ */
+void SoftwareRenderer::recordFrames(std::string const &pathPrefix, ImageFormat format,
+                                    std::size_t interval) {
+  _recordPrefix   = pathPrefix;
+  _recordFormat   = format;
+  _recordInterval = interval;
+}
+
+bool SoftwareRenderer::writeFrame(std::string const &path, ImageFormat format) const {
+  if (format == ImageFormat::kPpm) {
+    return ImageWriter::writePpm(path, _pixels.data(), _screenWidth, _screenHeight);
+  }
+  return ImageWriter::writePng(path, _pixels.data(), _screenWidth, _screenHeight);
+}
+
+const std::uint32_t *SoftwareRenderer::pixels() const {
+  return _pixels.data();
+}
+
+std::size_t SoftwareRenderer::width() const {
+  return _screenWidth;
+}
+
+std::size_t SoftwareRenderer::height() const {
+  return _screenHeight;
+}
+
+std::size_t SoftwareRenderer::frameCount() const {
+  return _frames;
+}
+
+// Collect what this frame shows, later entries win on shared cells
+void SoftwareRenderer::show_(SDL_Point const &point, Cell cell) {
+  if (point.x < 0 || point.y < 0 || point.x >= static_cast<int>(_gridWidth) ||
+      point.y >= static_cast<int>(_gridHeight)) {
+    return;
+  }
+  if (!_valid) { clear_(); }
+  _frameCells[point.y * _gridWidth + point.x] = cell;
+  _visibleCells.push_back(point);
+}
+
+// Repaint only the cells whose content differs from the pixel buffer
+void SoftwareRenderer::commitFrame_() {
+  if (!_valid) { clear_(); }
+
+  // Erase cells that were painted last frame and are empty now, walls and portals stay
+  for (SDL_Point const &point : _paintedCells) {
+    std::size_t index = point.y * _gridWidth + point.x;
+    Cell background = backgroundCell(_level, point);
+    if (_frameCells[index] == Cell::kEmpty && _canvasCells[index] != background) {
+      fillCell_(point, background);
+      _canvasCells[index] = background;
+    }
+  }
+
+  // Paint cells whose content changed
+  for (SDL_Point const &point : _visibleCells) {
+    std::size_t index = point.y * _gridWidth + point.x;
+    if (_canvasCells[index] != _frameCells[index]) {
+      fillCell_(point, _frameCells[index]);
+      _canvasCells[index] = _frameCells[index];
+    }
+  }
+
+  // Reset the scratch grid, the visible cells are what the buffer now holds
+  for (SDL_Point const &point : _visibleCells) {
+    _frameCells[point.y * _gridWidth + point.x] = Cell::kEmpty;
+  }
+  std::swap(_paintedCells, _visibleCells);
+  _visibleCells.clear();
+
+  ++_frames;
+  if (_recordInterval > 0 && _frames % _recordInterval == 0) {
+    char number[16];
+    std::snprintf(number, sizeof(number), "%06zu", _frames);
+    writeFrame(_recordPrefix + number + (_recordFormat == ImageFormat::kPpm ? ".ppm" : ".png"),
+               _recordFormat);
+  }
+}
+
+// Paint the background and the level's walls and portals over the whole buffer
+void SoftwareRenderer::clear_() {
+  fillSpan(_pixels.data(), _pixels.size(), pack_(cellColor(Cell::kEmpty)));
+  _canvasCells.assign(_gridWidth * _gridHeight, Cell::kEmpty);
+  _frameCells.assign(_gridWidth * _gridHeight, Cell::kEmpty);
+  _paintedCells.clear();
+  _visibleCells.clear();
+
+  if (nullptr != _level) {
+    for (int y = 0; y < static_cast<int>(_gridHeight); ++y) {
+      for (int x = 0; x < static_cast<int>(_gridWidth); ++x) {
+        SDL_Point point{x, y};
+        Cell cell = backgroundCell(_level, point);
+        if (cell == Cell::kEmpty) { continue; }
+        fillCell_(point, cell);
+        _canvasCells[y * _gridWidth + x] = cell;
+      }
+    }
+  }
+  _valid = true;
+}
+
+void SoftwareRenderer::fillCell_(SDL_Point const &point, Cell cell) {
+  std::uint32_t color = pack_(cellColor(cell));
+  std::uint32_t *row = _pixels.data() + point.y * _cellHeight * _screenWidth + point.x * _cellWidth;
+  for (std::size_t y = 0; y < _cellHeight; ++y, row += _screenWidth) {
+    fillSpan(row, _cellWidth, color);
+  }
+}
+
+std::uint32_t SoftwareRenderer::pack_(SDL_Color const &color) {
+  return static_cast<std::uint32_t>(color.r) | (static_cast<std::uint32_t>(color.g) << 8) |
+         (static_cast<std::uint32_t>(color.b) << 16) | (static_cast<std::uint32_t>(color.a) << 24);
+}
@@ -0,0 +1,78 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SDL.h"
+#include "level.h"
+#include "powerup.h"
+#include "render_backend.h"
+#include "snake.h"
+
+/*
+ * Rasterizes the board into a pixel buffer in memory, without a window
+ * or GPU, for headless recording, thumbnails and visual checks. The buffer
+ * persists between frames and only cells whose content changed are
+ * repainted, each as a few SIMD span fills, so a frame costs time in
+ * proportion to what moved rather than to the screen size. Frames can be
+ * written out as PPM or PNG.
+ */
+class SoftwareRenderer : public RenderBackend {
+ public:
+  // Define ImageFormat type
+  enum class ImageFormat { kPpm, kPng };
+
+  // Constructor
+  SoftwareRenderer(const std::size_t screenWidth, const std::size_t screenHeight,
+                   const std::size_t gridWidth, const std::size_t gridHeight);
+
+  // Public methods
+  void render(Snake const &snake, SDL_Point const &food, PowerUps const &powerUps,
+              RenderPath path = RenderPath::kFullRedraw) override;
+  void render(Snake const &first, Snake const &second, SDL_Point const &food) override;
+  void updateWindowTitle(std::string, int, bool, int = 0) override {}  // There is no window
+  void updateWindowTitle(std::string const &) override {}
+  void setLevel(Level const *level) override;
+  Uint32 windowId() const override;
+
+  void recordFrames(std::string const &pathPrefix, ImageFormat format, std::size_t interval);
+  bool writeFrame(std::string const &path, ImageFormat format) const;
+  const std::uint32_t *pixels() const;  // 0xAABBGGRR, row by row
+  std::size_t width() const;
+  std::size_t height() const;
+  std::size_t frameCount() const;
+
+ private:
+  // Private methods
+  void show_(SDL_Point const &point, Cell cell);
+  void commitFrame_();
+  void clear_();
+  void fillCell_(SDL_Point const &point, Cell cell);
+  static std::uint32_t pack_(SDL_Color const &color);
+
+  // Private data
+  std::vector<std::uint32_t> _pixels;
+  std::vector<Cell>          _canvasCells{};   // What is currently in the pixel buffer, per cell
+  std::vector<Cell>          _frameCells{};    // Scratch: what the current frame wants, per cell
+  std::vector<SDL_Point>     _paintedCells{};  // Non-empty cells in the pixel buffer
+  std::vector<SDL_Point>     _visibleCells{};  // Scratch: non-empty cells of the current frame
+  bool                       _valid{false};    // Whether _canvasCells matches the pixel buffer
+  Level const               *_level{nullptr};  // Walls and portals, none on the open board
+
+  std::size_t _screenWidth;
+  std::size_t _screenHeight;
+  std::size_t _gridWidth;
+  std::size_t _gridHeight;
+  std::size_t _cellWidth;
+  std::size_t _cellHeight;
+
+  // Recording, every _recordInterval-th frame is written to a numbered file
+  std::string _recordPrefix{};
+  ImageFormat _recordFormat{ImageFormat::kPng};
+  std::size_t _recordInterval{0};
+  std::size_t _frames{0};
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "timing_wheel.h"
+
+TimingWheel::TimingWheel(std::uint32_t now)
+    : _buckets(kLevels * kSlots, kNil), _now(now) {}
+
+/*
+ * Fire payload once the wheel reaches the deadline tick
+ * Deadlines that are not in the future fire on the next advance().
+ */
+TimingWheel::TimerId TimingWheel::schedule(std::uint32_t deadline, std::uint32_t payload) {
+  if (deadline <= _now) { deadline = _now + 1; }
+
+  std::uint32_t index;
+  if (_freeList != kNil) {
+    index = _freeList;
+    _freeList = _nodes[index].next;
+  } else {
+    index = static_cast<std::uint32_t>(_nodes.size());
+    _nodes.push_back(Node{0, 0, kNil, kNil, kNil, 0});
+  }
+
+  Node &node = _nodes[index];
+  node.deadline = deadline;
+  node.payload  = payload;
+  link_(index);
+  ++_pending;
+
+  // Index is offset by one so that no valid timer equals kInvalidTimer
+  return (static_cast<TimerId>(node.generation) << 32) | (index + 1u);
+}
+
+// Returns false if the timer already fired or was cancelled
+bool TimingWheel::cancel(TimerId timer) {
+  std::uint32_t index = static_cast<std::uint32_t>(timer & 0xFFFFFFFFu) - 1u;
+  std::uint32_t generation = static_cast<std::uint32_t>(timer >> 32);
+  if (timer == kInvalidTimer || index >= _nodes.size()) { return false; }
+
+  Node &node = _nodes[index];
+  if (node.bucket == kNil || node.generation != generation) { return false; }
+
+  unlink_(index);
+  release_(index);
+  --_pending;
+  return true;
+}
+
+// Move to the next tick and append the payloads of all timers due at it
+void TimingWheel::advance(std::vector<std::uint32_t> &expired) {
+  ++_now;
+
+  // Higher levels first, so their timers can fall through several levels at once
+  for (int level = kLevels - 1; level > 0; --level) {
+    std::uint32_t lowerMask = (1u << (kSlotBits * level)) - 1u;
+    if ((_now & lowerMask) == 0) { cascade_(level); }
+  }
+
+  std::uint32_t &head = _buckets[_now & (kSlots - 1)];
+  while (head != kNil) {
+    std::uint32_t index = head;
+    expired.push_back(_nodes[index].payload);
+    unlink_(index);
+    release_(index);
+    --_pending;
+  }
+}
+
+// Drop every pending timer and restart the wheel at the given tick
+void TimingWheel::reset(std::uint32_t now) {
+  for (std::uint32_t index = 0; index < _nodes.size(); ++index) {
+    if (_nodes[index].bucket != kNil) {
+      unlink_(index);
+      release_(index);
+    }
+  }
+  _pending = 0;
+  _now = now;
+}
+
+std::uint32_t TimingWheel::now() const {
+  return _now;
+}
+
+std::size_t TimingWheel::pending() const {
+  return _pending;
+}
+
+// Insert a node into the slot matching its distance from the current tick
+void TimingWheel::link_(std::uint32_t index) {
+  Node &node = _nodes[index];
+  std::uint32_t difference = node.deadline ^ _now;
+  int level = 0;
+  while (level + 1 < kLevels && (difference >> (kSlotBits * (level + 1))) != 0) {
+    ++level;
+  }
+  std::uint32_t slot = (node.deadline >> (kSlotBits * level)) & (kSlots - 1);
+
+  node.bucket = static_cast<std::uint32_t>(level) * kSlots + slot;
+  node.prev   = kNil;
+  node.next   = _buckets[node.bucket];
+  if (node.next != kNil) { _nodes[node.next].prev = index; }
+  _buckets[node.bucket] = index;
+}
+
+void TimingWheel::unlink_(std::uint32_t index) {
+  Node &node = _nodes[index];
+  if (node.prev != kNil) {
+    _nodes[node.prev].next = node.next;
+  } else {
+    _buckets[node.bucket] = node.next;
+  }
+  if (node.next != kNil) { _nodes[node.next].prev = node.prev; }
+  node.bucket = kNil;
+}
+
+void TimingWheel::release_(std::uint32_t index) {
+  Node &node = _nodes[index];
+  ++node.generation;
+  node.next = _freeList;
+  _freeList = index;
+}
+
+// Re-file the timers of the current slot of a level into the levels below
+void TimingWheel::cascade_(int level) {
+  std::uint32_t bucket = static_cast<std::uint32_t>(level) * kSlots +
+                         ((_now >> (kSlotBits * level)) & (kSlots - 1));
+  std::uint32_t index = _buckets[bucket];
+  _buckets[bucket] = kNil;
+  while (index != kNil) {
+    std::uint32_t next = _nodes[index].next;
+    link_(index);
+    index = next;
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Hierarchical timing wheel keyed on simulation ticks
+ *
+ * Four levels of 256 slots cover the whole 32 bit tick range. A timer sits
+ * in the level of the highest byte in which its deadline differs from the
+ * current tick, and is cascaded one level down each time the lower wheel
+ * wraps around. Timers are pooled nodes in intrusive doubly linked slot
+ * lists, so schedule() and cancel() are O(1) and an idle tick only looks
+ * at one empty slot, however many timers are pending.
+ */
+class TimingWheel {
+ public:
+  using TimerId = std::uint64_t;
+  static constexpr TimerId kInvalidTimer{0};
+
+  // Constructor
+  explicit TimingWheel(std::uint32_t now = 0);
+
+  // Public methods
+  TimerId schedule(std::uint32_t deadline, std::uint32_t payload);
+  bool cancel(TimerId timer);
+  void advance(std::vector<std::uint32_t> &expired);
+  void reset(std::uint32_t now);
+  std::uint32_t now() const;
+  std::size_t pending() const;
+
+ private:
+  static constexpr int           kLevels{4};
+  static constexpr int           kSlotBits{8};
+  static constexpr std::uint32_t kSlots{1u << kSlotBits};
+  static constexpr std::uint32_t kNil{0xFFFFFFFFu};
+
+  struct Node {
+    std::uint32_t deadline;
+    std::uint32_t payload;
+    std::uint32_t prev;
+    std::uint32_t next;
+    std::uint32_t bucket;      // level * kSlots + slot, or kNil when free
+    std::uint32_t generation;  // Bumped on release so stale TimerIds are rejected
+  };
+
+  // Private methods
+  void link_(std::uint32_t index);
+  void unlink_(std::uint32_t index);
+  void release_(std::uint32_t index);
+  void cascade_(int level);
+
+  // Private data
+  std::vector<Node>          _nodes{};
+  std::vector<std::uint32_t> _buckets;       // Head node of each slot list
+  std::uint32_t              _freeList{kNil};
+  std::uint32_t              _now;
+  std::size_t                _pending{0};
+};
+
+#endif
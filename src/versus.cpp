@@ -0,0 +1,142 @@
+#include "versus.h"
+
+namespace {
+// FNV-1a over the bytes of a value
+void hashValue(std::uint32_t &hash, const void *data, std::size_t size) {
+  auto bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+}
+}  // namespace
+
+VersusSimulation::VersusSimulation(std::size_t gridWidth, std::size_t gridHeight,
+                                   std::uint64_t seed)
+    : _gridWidth(gridWidth),
+      _gridHeight(gridHeight),
+      _snakes{Snake(gridWidth, gridHeight), Snake(gridWidth, gridHeight)},
+      _random(seed) {
+  // Start the players on opposite halves of the board, heading away from each other
+  _snakes[0].headX = static_cast<float>(gridWidth / 4);
+  _snakes[0].headY = static_cast<float>(gridHeight / 2);
+  _snakes[0].direction = Snake::Direction::kUp;
+  _snakes[1].headX = static_cast<float>(3 * gridWidth / 4);
+  _snakes[1].headY = static_cast<float>(gridHeight / 2);
+  _snakes[1].direction = Snake::Direction::kDown;
+  placeFood_();
+}
+
+/*
+ * Advance the match by one tick
+ * A snake dies when it runs into itself or into the other snake; a head
+ * on collision kills both. Once a snake is dead the board freezes.
+ */
+void VersusSimulation::step(std::array<PlayerInput, kVersusPlayers> const &inputs) {
+  ++_tick;
+  if (finished()) { return; }
+
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    if (inputs[p] != kNoInput) { _snakes[p].steer(decodeDirection(inputs[p])); }
+    _snakes[p].update();
+  }
+
+  // Decide all collisions before applying them, so player order does not matter
+  std::array<bool, kVersusPlayers> crashed{};
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    Snake const &other = _snakes[1 - p];
+    crashed[p] = other.snakeCell(static_cast<int>(_snakes[p].headX),
+                                 static_cast<int>(_snakes[p].headY));
+  }
+
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    Snake &snake = _snakes[p];
+    if (crashed[p]) { snake.alive = false; }
+    if (!snake.alive) { continue; }
+
+    // Check if there's food over here
+    if (_food.x == static_cast<int>(snake.headX) && _food.y == static_cast<int>(snake.headY)) {
+      _scores[p] += 10;
+      placeFood_();
+      // Grow snake and increase speed.
+      snake.growBody();
+      snake.speed += 0.02;
+    }
+  }
+}
+
+bool VersusSimulation::save(VersusState &state) const {
+  state.tick   = _tick;
+  state.food   = _food;
+  state.random = _random;
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    state.scores[p] = _scores[p];
+    if (!_snakes[p].save(state.snakes[p])) { return false; }
+  }
+  return true;
+}
+
+void VersusSimulation::restore(VersusState const &state) {
+  _tick   = state.tick;
+  _food   = state.food;
+  _random = state.random;
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    _scores[p] = state.scores[p];
+    _snakes[p].restore(state.snakes[p]);
+  }
+}
+
+/*
+ * Hash of everything that affects the outcome, for desync detection
+ * Hashes field by field, so struct padding never leaks into the result.
+ */
+std::uint32_t VersusSimulation::checksum() const {
+  std::uint32_t hash = 2166136261u;
+  hashValue(hash, &_tick, sizeof(_tick));
+  hashValue(hash, &_food.x, sizeof(_food.x));
+  hashValue(hash, &_food.y, sizeof(_food.y));
+  for (int p = 0; p < kVersusPlayers; ++p) {
+    Snake const &snake = _snakes[p];
+    hashValue(hash, &_scores[p], sizeof(_scores[p]));
+    hashValue(hash, &snake.headX, sizeof(snake.headX));
+    hashValue(hash, &snake.headY, sizeof(snake.headY));
+    hashValue(hash, &snake.speed, sizeof(snake.speed));
+    hashValue(hash, &snake.size, sizeof(snake.size));
+    hashValue(hash, &snake.alive, sizeof(snake.alive));
+    for (SDL_Point const &point : snake.body) {
+      hashValue(hash, &point.x, sizeof(point.x));
+      hashValue(hash, &point.y, sizeof(point.y));
+    }
+  }
+  return hash;
+}
+
+bool VersusSimulation::finished() const {
+  return !_snakes[0].alive || !_snakes[1].alive;
+}
+
+// Index of the surviving player, or -1 for a draw or a match in progress
+int VersusSimulation::winner() const {
+  if (_snakes[0].alive == _snakes[1].alive) { return -1; }
+  return _snakes[0].alive ? 0 : 1;
+}
+
+// Getters definition
+Snake const &VersusSimulation::snake(int player) const { return _snakes[player]; }
+SDL_Point const &VersusSimulation::food() const         { return _food;            }
+int VersusSimulation::score(int player) const           { return _scores[player];  }
+std::uint32_t VersusSimulation::tick() const            { return _tick;            }
+
+void VersusSimulation::placeFood_() {
+  int x, y;
+  while (true) {
+    x = _random.uniform(1, static_cast<int>(_gridWidth) - 1);
+    y = _random.uniform(1, static_cast<int>(_gridHeight) - 1);
+    // Check that the location is not occupied by either snake before placing food.
+    if (!_snakes[0].snakeCell(x, y) && !_snakes[1].snakeCell(x, y)) {
+      _food.x = x;
+      _food.y = y;
+      return;
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef VERSUS_H
+#define VERSUS_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "SDL.h"
+#include "input.h"
+#include "random.h"
+#include "snake.h"
+#include "snapshot.h"
+
+constexpr int kVersusPlayers{2};
+
+// Complete state of a head-to-head match in a fixed layout
+struct VersusState {
+  std::uint32_t tick;
+  SDL_Point     food;
+  Random        random;
+  int           scores[kVersusPlayers];
+  SnakeState    snakes[kVersusPlayers];
+};
+
+static_assert(std::is_trivially_copyable<VersusState>::value,
+              "VersusState must stay memcpy-able");
+
+/*
+ * Deterministic two player simulation
+ * The next state depends only on the current state and the inputs of
+ * both players for the tick, so two peers stepping with the same inputs
+ * stay in sync without ever exchanging game state.
+ */
+class VersusSimulation {
+ public:
+  // Constructor
+  VersusSimulation(std::size_t gridWidth, std::size_t gridHeight, std::uint64_t seed);
+
+  // Public methods
+  void step(std::array<PlayerInput, kVersusPlayers> const &inputs);
+  bool save(VersusState &state) const;
+  void restore(VersusState const &state);
+  std::uint32_t checksum() const;
+  bool finished() const;
+  int winner() const;
+
+  // Getters
+  Snake const &snake(int player) const;
+  SDL_Point const &food() const;
+  int score(int player) const;
+  std::uint32_t tick() const;
+
+ private:
+  // Private methods
+  void placeFood_();
+
+  // Private data
+  std::size_t _gridWidth;
+  std::size_t _gridHeight;
+  std::array<Snake, kVersusPlayers> _snakes;
+  SDL_Point     _food;
+  Random        _random;
+  std::array<int, kVersusPlayers> _scores{};
+  std::uint32_t _tick{0};
+};
+
+#endif